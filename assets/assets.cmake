@@ -0,0 +1,29 @@
+# Assets do jogo: sprites e fontes compilados para o formato do SSD1306.
+#
+#   add_game_assets(<target>)
+#
+# Os arquivos são gerados uma vez só, pelo alvo game_assets, e compilados
+# em cada alvo que os usa.
+
+include(${CMAKE_CURRENT_LIST_DIR}/../tools/assets.cmake)
+
+set(GAME_ASSETS_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+function(add_game_assets target)
+    if(NOT TARGET game_assets)
+        add_custom_target(game_assets)
+
+        add_display_asset(game_assets sprite player ${GAME_ASSETS_DIR}/player.pbm)
+        add_display_asset(game_assets sprite alien ${GAME_ASSETS_DIR}/alien.pbm)
+        add_display_asset(game_assets sprite bullet ${GAME_ASSETS_DIR}/bullet.pbm)
+        add_display_asset(game_assets image starfield ${GAME_ASSETS_DIR}/starfield.pbm)
+
+        # texto do HUD e títulos das telas
+        add_display_font(game_assets font_small ${GAME_ASSETS_DIR}/fonts/font_small.pbm
+                CELL 5x8 LAST 126 SPACING 1 SPACE_WIDTH 3)
+        add_display_font(game_assets font_large ${GAME_ASSETS_DIR}/fonts/font_large.pbm
+                CELL 10x16 LAST 126 SPACING 2 SPACE_WIDTH 5)
+    endif()
+
+    target_display_assets(${target} game_assets)
+endfunction()
@@ -0,0 +1,477 @@
+/*
+ * Microbenchmark das primitivas de desenho do ssd1306 e de um quadro
+ * completo do jogo.
+ *
+ * Roda no Linux (build em host/, relógio monotônico) e no RP2040
+ * (alvo render_bench, contagem de ciclos pelo SysTick). A saída é CSV:
+ *
+ *   bench,platform,revision,ops,ns_per_op,bytes_touched
+ *
+ * bytes_touched é o número de bytes do framebuffer alterados por uma
+ * operação sobre a tela limpa; para frame_render, os alterados entre dois
+ * quadros consecutivos, e para frame_show, os bytes enviados ao display
+ * nessa troca.
+ *
+ * No RP2040 o envio também é medido com o display de verdade em cada
+ * transporte (linhas full_show_<transporte> e frame_show_<transporte>):
+ * ns_per_op é o tempo de um quadro no barramento, quadros por segundo =
+ * 1e9 / ns_per_op.
+ *
+ * Os quadros do nível de estresse (stress_show e stress_show_<transporte>)
+ * têm de caber no orçamento de 30 fps: cada um ganha uma linha de
+ * comentário "# ok" ou "# FAIL", e no host o programa sai com erro se
+ * algum passar do orçamento.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "render.h"
+#include "alien_fleet.h"
+#include "bullet_pool.h"
+#include "game_sim.h"
+#include "asset_checker.h"
+#include "font_small.h"
+
+#ifdef SSD1306_HOST
+#include <time.h>
+#define BENCH_PLATFORM "host"
+#else
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/i2c.h"
+#include "ssd1306_pio.h"
+#define BENCH_PLATFORM "rp2040"
+
+// Display da BitDogLab; o SPI só é medido se os pinos forem definidos no build
+// (-DBENCH_SPI_MOSI_PIN=... e os demais)
+#define BENCH_I2C_PORT i2c1
+#define BENCH_I2C_SDA_PIN 14
+#define BENCH_I2C_SCL_PIN 15
+#define BENCH_OLED_ADDRESS 0x3C
+#ifndef BENCH_PIO_I2C_HZ
+#define BENCH_PIO_I2C_HZ (1000 * 1000)
+#endif
+#ifndef BENCH_SPI_HZ
+#define BENCH_SPI_HZ (10 * 1000 * 1000)
+#endif
+#endif
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+#define BENCH_OPS_FAST 20000    // primitivas baratas (pixel, linha, ...)
+#define BENCH_OPS_SLOW 2000     // quadro completo
+#define BENCH_BMP_SIZE 32       // lado da imagem BMP de teste
+#define BENCH_OPS_BUS 100       // quadro enviado ao display de verdade
+#define BENCH_FRAME_BUDGET_NS (1000000000u / 30)    // um quadro a 30 fps
+
+typedef void (*bench_fn_t)(ssd1306_t *p, uint32_t i);
+
+typedef struct {
+    const char *name;
+    bench_fn_t fn;
+    uint32_t ops;
+    bool budget;        // quadro inteiro: tem de caber em BENCH_FRAME_BUDGET_NS
+} bench_case_t;
+
+static GameState_t frame_states[2];
+static GameState_t bullet_states[2];    // mesma frota, só os tiros se movem
+static GameState_t stress_states[2];    // nível de estresse: frota 8x16 e 64 tiros
+static uint8_t bmp_image[62 + BENCH_BMP_SIZE * 4];
+
+// Transporte que descarta os dados: mede só o custo de CPU do envio
+static bool sink_write(void *ctx, const uint8_t *src, size_t len) {
+    (void)ctx;
+    (void)src;
+    (void)len;
+    return true;
+}
+
+static const ssd1306_transport_t sink_transport = {
+    .write = sink_write,
+};
+
+// ---------------------------------------------------------------------------
+// Relógio
+// ---------------------------------------------------------------------------
+
+#ifdef SSD1306_HOST
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Mede o lote inteiro: o custo do relógio fica fora de cada operação
+static uint64_t run_case(ssd1306_t *p, bench_fn_t fn, uint32_t ops) {
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < ops; ++i)
+        fn(p, i);
+    return now_ns() - start;
+}
+#else
+#define SYSTICK_MASK 0x00ffffffu
+
+static uint32_t systick_overhead;
+
+// O SysTick tem 24 bits (~134 ms a 125 MHz), então cada chamada é medida
+// isoladamente e os ciclos são acumulados em 64 bits
+static uint64_t run_cycles(ssd1306_t *p, bench_fn_t fn, uint32_t ops) {
+    uint64_t cycles = 0;
+
+    for (uint32_t i = 0; i < ops; ++i) {
+        uint32_t start = systick_hw->cvr;
+        fn(p, i);
+        uint32_t elapsed = (start - systick_hw->cvr) & SYSTICK_MASK;
+        cycles += elapsed > systick_overhead ? elapsed - systick_overhead : 0;
+    }
+    return cycles;
+}
+
+static void empty_op(ssd1306_t *p, uint32_t i) {
+    (void)p;
+    (void)i;
+}
+
+static void systick_start(void) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // habilitado, clock do processador
+
+    systick_overhead = 0;
+    systick_overhead = (uint32_t)(run_cycles(NULL, empty_op, 64) / 64);
+}
+
+static uint64_t run_case(ssd1306_t *p, bench_fn_t fn, uint32_t ops) {
+    return run_cycles(p, fn, ops) * 1000000000u / clock_get_hz(clk_sys);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Casos
+// ---------------------------------------------------------------------------
+
+static void bench_clear(ssd1306_t *p, uint32_t i) {
+    (void)i;
+    ssd1306_clear(p);
+}
+
+static void bench_pixel(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_pixel(p, (i * 7) % SSD1306_WIDTH, (i * 3) % SSD1306_HEIGHT);
+}
+
+static void bench_line(ssd1306_t *p, uint32_t i) {
+    uint32_t y = i % SSD1306_HEIGHT;
+    ssd1306_draw_line(p, 0, y, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1 - y);
+}
+
+static void bench_square(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_square(p, i % (SSD1306_WIDTH - 20), i % (SSD1306_HEIGHT - 10), 20, 10);
+}
+
+static void bench_string(ssd1306_t *p, uint32_t i) {
+    (void)i;
+    ssd1306_draw_string(p, 0, 0, 1, "SCORE: 120");
+}
+
+static void bench_text(ssd1306_t *p, uint32_t i) {
+    (void)i;
+    ssd1306_draw_text(p, 0, 0, &font_small, "SCORE: 120");
+}
+
+static void bench_bmp(ssd1306_t *p, uint32_t i) {
+    ssd1306_bmp_show_image_with_offset(p, bmp_image, sizeof(bmp_image),
+                                       i % (SSD1306_WIDTH - BENCH_BMP_SIZE + 1),
+                                       i % (SSD1306_HEIGHT - BENCH_BMP_SIZE + 1));
+}
+
+// Mesma imagem do BMP, compilada para páginas no build
+static void bench_image(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_image(p, &asset_checker, i % (SSD1306_WIDTH - ASSET_CHECKER_WIDTH + 1),
+                       i % (SSD1306_HEIGHT - ASSET_CHECKER_HEIGHT + 1), SSD1306_SPRITE_OPAQUE);
+}
+
+static void bench_frame_render(ssd1306_t *p, uint32_t i) {
+    render_frame(p, &frame_states[i & 1]);
+}
+
+static void bench_frame_bullets(ssd1306_t *p, uint32_t i) {
+    render_frame(p, &bullet_states[i & 1]);
+}
+
+static void bench_frame_show(ssd1306_t *p, uint32_t i) {
+    render_frame(p, &frame_states[i & 1]);
+    ssd1306_show(p);
+}
+
+static void bench_stress_render(ssd1306_t *p, uint32_t i) {
+    render_frame(p, &stress_states[i & 1]);
+}
+
+static void bench_stress_show(ssd1306_t *p, uint32_t i) {
+    render_frame(p, &stress_states[i & 1]);
+    ssd1306_show(p);
+}
+
+// Pior caso do barramento: o buffer inteiro a cada quadro
+static void bench_full_show(ssd1306_t *p, uint32_t i) {
+    (void)i;
+    ssd1306_invalidate(p);
+    ssd1306_show(p);
+}
+
+static const bench_case_t bench_cases[] = {
+    {"clear", bench_clear, BENCH_OPS_FAST, false},
+    {"draw_pixel", bench_pixel, BENCH_OPS_FAST, false},
+    {"draw_line", bench_line, BENCH_OPS_FAST, false},
+    {"draw_square", bench_square, BENCH_OPS_FAST, false},
+    {"draw_string", bench_string, BENCH_OPS_FAST, false},
+    {"draw_text", bench_text, BENCH_OPS_FAST, false},
+    {"bmp_show_image_with_offset", bench_bmp, BENCH_OPS_SLOW, false},
+    {"draw_image", bench_image, BENCH_OPS_FAST, false},
+    {"frame_render", bench_frame_render, BENCH_OPS_SLOW, false},
+    {"frame_render_bullets", bench_frame_bullets, BENCH_OPS_SLOW, false},
+    {"frame_show", bench_frame_show, BENCH_OPS_SLOW, false},
+    {"stress_render", bench_stress_render, BENCH_OPS_SLOW, false},
+    {"stress_show", bench_stress_show, BENCH_OPS_SLOW, true},
+};
+
+// ---------------------------------------------------------------------------
+// Dados de entrada
+// ---------------------------------------------------------------------------
+
+static void put_le(uint8_t *dst, uint32_t val, int size) {
+    for (int i = 0; i < size; ++i)
+        dst[i] = (uint8_t)(val >> (8 * i));
+}
+
+// BMP monocromático com um xadrez de 4x4 pixels
+static void make_bmp(void) {
+    uint8_t *b = bmp_image;
+
+    memset(b, 0, sizeof(bmp_image));
+    b[0] = 'B';
+    b[1] = 'M';
+    put_le(b + 2, sizeof(bmp_image), 4);
+    put_le(b + 10, 62, 4);             // bfOffBits
+    put_le(b + 14, 40, 4);             // biSize
+    put_le(b + 18, BENCH_BMP_SIZE, 4); // biWidth
+    put_le(b + 22, BENCH_BMP_SIZE, 4); // biHeight (de baixo para cima)
+    put_le(b + 26, 1, 2);              // biPlanes
+    put_le(b + 28, 1, 2);              // biBitCount
+    put_le(b + 58, 0xffffff, 3);       // cor 1 = branco, cor 0 = preto
+
+    for (int y = 0; y < BENCH_BMP_SIZE; ++y)
+        memset(b + 62 + y * 4, (y & 4) ? 0x0f : 0xf0, 4);
+}
+
+// Dois quadros de jogo com tudo deslocado, para o diff ter trabalho, e
+// dois em que só os tiros mudam, o caso comum entre passos da frota
+static void make_frame_states(void) {
+    for (int f = 0; f < 2; ++f) {
+        GameState_t *state = &frame_states[f];
+
+        memset(state, 0, sizeof(*state));
+        state->current_game_internal_state = GAME_PLAYING;
+        state->level = GAME_LEVEL_NORMAL;
+        game_sim_reset(state);
+        state->player_obj.x += f;
+        alien_fleet_move(&state->fleet, f * 2, 0);
+        for (int r = 0; r < state->fleet.formation.rows; ++r)
+            for (int c = 0; c < state->fleet.formation.cols; ++c)
+                if ((r + c) % 4 == 0)
+                    alien_fleet_kill(&state->fleet, r, c);
+        bullet_pool_spawn(&state->bullets, state->player_obj.x + PLAYER_WIDTH / 2, 40 - f * 4);
+        bullet_pool_spawn(&state->enemy_bullets, 40, 30 + f * 3);
+        bullet_pool_spawn(&state->enemy_bullets, 90, 45 + f * 3);
+        state->score = 120;
+        state->lives = 2;
+
+        bullet_states[f] = frame_states[0];
+        bullet_states[f].bullets = state->bullets;
+        bullet_states[f].enemy_bullets = state->enemy_bullets;
+
+        // Pior caso do nível de estresse: a frota inteira anda e todos os tiros estão no ar
+        GameState_t *stress = &stress_states[f];
+
+        memset(stress, 0, sizeof(*stress));
+        stress->current_game_internal_state = GAME_PLAYING;
+        stress->level = GAME_LEVEL_STRESS;
+        game_sim_reset(stress);
+        alien_fleet_move(&stress->fleet, f * 2, 0);
+        for (int i = 0; i < stress->bullets.capacity; ++i)
+            bullet_pool_spawn(&stress->bullets, (i * 37) % OLED_WIDTH, 52 - (i % 4) * 3 - f * 2);
+        for (int i = 0; i < stress->enemy_bullets.capacity; ++i)
+            bullet_pool_spawn(&stress->enemy_bullets, (i * 29 + 3) % OLED_WIDTH, 50 + (i % 5) * 2 + f * 2);
+    }
+}
+
+// Bytes alterados por uma operação a partir da tela limpa
+static uint32_t bytes_touched(ssd1306_t *p, const bench_case_t *c) {
+    static uint8_t before[SSD1306_BUFSIZE];
+    ssd1306_stats_t stats;
+    uint32_t count = 0;
+
+    if (c->fn == bench_frame_show || c->fn == bench_full_show || c->fn == bench_stress_show) {
+        c->fn(p, 0);
+        c->fn(p, 1);
+        ssd1306_get_stats(p, &stats);
+        return stats.last_bytes;
+    }
+
+    // O renderizador é incremental: conta o que muda entre dois quadros
+    if (c->fn == bench_frame_render || c->fn == bench_frame_bullets || c->fn == bench_stress_render) {
+        c->fn(p, 0);
+        memcpy(before, p->buffer, SSD1306_BUFSIZE);
+        c->fn(p, 1);
+        for (size_t i = 0; i < SSD1306_BUFSIZE; ++i)
+            count += p->buffer[i] != before[i];
+        return count;
+    }
+
+    memset(p->buffer, c->fn == bench_clear ? 0xff : 0x00, SSD1306_BUFSIZE);
+    c->fn(p, 0);
+    for (size_t i = 0; i < SSD1306_BUFSIZE; ++i)
+        count += p->buffer[i] != (c->fn == bench_clear ? 0xff : 0x00);
+    return count;
+}
+
+// Retorna false se o caso tem orçamento de quadro e passou dele
+static bool run_one(ssd1306_t *p, const bench_case_t *c, const char *suffix) {
+    ssd1306_clear(p);
+    render_invalidate();
+    uint32_t touched = bytes_touched(p, c);
+
+    ssd1306_clear(p);
+    render_invalidate();
+    uint64_t ns = run_case(p, c->fn, c->ops);
+
+    printf("%s%s,%s,%s,%lu,%lu.%03lu,%lu\n", c->name, suffix, BENCH_PLATFORM, BENCH_REVISION,
+           (unsigned long)c->ops,
+           (unsigned long)(ns / c->ops), (unsigned long)(ns * 1000 / c->ops % 1000),
+           (unsigned long)touched);
+
+    if (!c->budget)
+        return true;
+
+    bool ok = ns / c->ops <= BENCH_FRAME_BUDGET_NS;
+    printf("# %s %s%s: %lu us por quadro, orcamento de 30 fps %lu us\n", ok ? "ok" : "FAIL",
+           c->name, suffix, (unsigned long)(ns / c->ops / 1000), (unsigned long)(BENCH_FRAME_BUDGET_NS / 1000));
+    return ok;
+}
+
+static bool run_all(ssd1306_t *p) {
+    bool ok = true;
+
+    printf("bench,platform,revision,ops,ns_per_op,bytes_touched\n");
+
+    for (size_t n = 0; n < sizeof(bench_cases) / sizeof(bench_cases[0]); ++n)
+        ok &= run_one(p, &bench_cases[n], "");
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Transportes (só no RP2040, com o display conectado)
+// ---------------------------------------------------------------------------
+
+#ifndef SSD1306_HOST
+typedef struct {
+    const char *suffix;
+    bool (*init)(ssd1306_t *p);
+} bench_transport_t;
+
+static ssd1306_pio_t bench_pio;
+
+static bool init_hw_i2c(ssd1306_t *p, uint baudrate) {
+    i2c_init(BENCH_I2C_PORT, baudrate);
+    gpio_set_function(BENCH_I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(BENCH_I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(BENCH_I2C_SDA_PIN);
+    gpio_pull_up(BENCH_I2C_SCL_PIN);
+    return ssd1306_init(p, BENCH_OLED_ADDRESS, BENCH_I2C_PORT) && ssd1306_dma_init(p, NULL, NULL);
+}
+
+static bool init_i2c_400k(ssd1306_t *p) {
+    return init_hw_i2c(p, 400 * 1000);
+}
+
+static bool init_i2c_1m(ssd1306_t *p) {
+    return init_hw_i2c(p, 1000 * 1000);
+}
+
+static bool init_pio_i2c(ssd1306_t *p) {
+    i2c_deinit(BENCH_I2C_PORT);
+    return ssd1306_init_pio_i2c(p, &bench_pio, pio0, BENCH_I2C_SDA_PIN, BENCH_I2C_SCL_PIN,
+                                BENCH_OLED_ADDRESS, BENCH_PIO_I2C_HZ);
+}
+
+#ifdef BENCH_SPI_MOSI_PIN
+static bool init_pio_spi(ssd1306_t *p) {
+    return ssd1306_init_pio_spi(p, &bench_pio, pio0, BENCH_SPI_MOSI_PIN, BENCH_SPI_SCK_PIN,
+                                BENCH_SPI_DC_PIN, BENCH_SPI_CS_PIN, BENCH_SPI_RST_PIN, BENCH_SPI_HZ);
+}
+#endif
+
+static const bench_transport_t bench_transports[] = {
+    {"_i2c_400k", init_i2c_400k},
+    {"_i2c_1m", init_i2c_1m},
+    {"_pio_i2c", init_pio_i2c},
+#ifdef BENCH_SPI_MOSI_PIN
+    {"_pio_spi", init_pio_spi},
+#endif
+};
+
+static const bench_case_t bus_cases[] = {
+    {"full_show", bench_full_show, BENCH_OPS_BUS, false},
+    {"frame_show", bench_frame_show, BENCH_OPS_BUS, false},
+    {"stress_show", bench_stress_show, BENCH_OPS_BUS, true},
+};
+
+static bool run_transports(ssd1306_t *p) {
+    bool ok = true;
+
+    for (size_t t = 0; t < sizeof(bench_transports) / sizeof(bench_transports[0]); ++t) {
+        if (!bench_transports[t].init(p)) {
+            printf("# transporte%s indisponivel\n", bench_transports[t].suffix);
+            continue;
+        }
+        for (size_t n = 0; n < sizeof(bus_cases) / sizeof(bus_cases[0]); ++n)
+            ok &= run_one(p, &bus_cases[n], bench_transports[t].suffix);
+        ssd1306_deinit(p);
+    }
+    return ok;
+}
+#endif
+
+int main(void) {
+    static ssd1306_t oled;
+
+#ifndef SSD1306_HOST
+    stdio_init_all();
+    sleep_ms(2000); // tempo para o terminal USB conectar
+    systick_start();
+#endif
+
+    if (!ssd1306_init_with_transport(&oled, &sink_transport, NULL)) {
+        printf("erro ao inicializar o display\n");
+        return 1;
+    }
+    make_bmp();
+    make_frame_states();
+
+    bool ok = run_all(&oled);
+
+    ssd1306_deinit(&oled);
+
+#ifndef SSD1306_HOST
+    ok &= run_transports(&oled);
+    printf("# orcamento de 30 fps: %s\n", ok ? "ok" : "FAIL");
+
+    while (true)
+        tight_loop_contents();
+#endif
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/*
+ * Vazão da simulação do jogo: passos de game_sim_step por segundo, para
+ * cada nível (game_levels) com frotas e quantidades de tiros diferentes.
+ *
+ * Roda no Linux (build em host/) e no RP2040 (alvo sim_bench). A saída é CSV:
+ *
+ *   bench,platform,revision,level,aliens,bullets,steps,ns_per_step,steps_per_s
+ *
+ * Um passo simula SIM_STEP_MS; steps_per_s / (1000 / SIM_STEP_MS) é quantas
+ * vezes mais rápido que o tempo real a simulação roda nessa plataforma.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "game_sim.h"
+#include "alien_fleet.h"
+#include "bullet_pool.h"
+
+#ifdef BENCH_HOST
+#include <time.h>
+#define BENCH_PLATFORM "host"
+#define BENCH_STEPS 2000000
+#else
+#include "pico/stdlib.h"
+#define BENCH_PLATFORM "rp2040"
+#define BENCH_STEPS 100000
+#endif
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+#define BENCH_SEED 1
+#define BENCH_BATCH_STEPS 60    // passos a partir do mesmo estado inicial (600 ms de jogo)
+
+static GameState_t start_state;
+static GameState_t state;
+
+#ifdef BENCH_HOST
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#else
+static uint64_t now_ns(void) {
+    return time_us_64() * 1000u;
+}
+#endif
+
+// Partida do nível `level` em andamento com `aliens` vivos e `bullets` tiros
+// no ar (os do jogador primeiro), longe do jogador para ninguém perder vida no lote
+static void make_start_state(uint8_t level, int aliens, int bullets) {
+    memset(&start_state, 0, sizeof(start_state));
+    start_state.current_game_internal_state = GAME_PLAYING;
+    start_state.level = level;
+    game_sim_seed(&start_state, BENCH_SEED);
+    game_sim_reset(&start_state);
+
+    // Mata em ordem espalhada: as bordas e os atiradores mudam ao longo da lista
+    const AlienFormation *f = &start_state.fleet.formation;
+    for (int i = 0; start_state.fleet.count > aliens; ++i) {
+        int n = (i * 7) % (f->rows * f->cols);
+        if (alien_fleet_alive(&start_state.fleet, n / f->cols, n % f->cols))
+            alien_fleet_kill(&start_state.fleet, n / f->cols, n % f->cols);
+    }
+
+    for (int i = 0; i < bullets; ++i) {
+        if (!bullet_pool_spawn(&start_state.bullets, start_state.player_obj.x + PLAYER_WIDTH / 2,
+                               PLAYER_Y_POS - 1 - (i % 8) * 4))
+            bullet_pool_spawn(&start_state.enemy_bullets, (5 + i * 11) % OLED_WIDTH, 20 + (i % 3) * 6);
+    }
+}
+
+// O jogador anda de um lado para o outro e atira sempre que pode
+static void run_batch(uint32_t first) {
+    state = start_state;
+    for (uint32_t i = 0; i < BENCH_BATCH_STEPS; ++i) {
+        uint32_t t = first + i;
+        GameInput_t input = {(t / 64) & 1 ? 1 : -1, (t & 8) != 0};
+        game_sim_step(&state, &input);
+    }
+}
+
+static void run_case(uint8_t level, int aliens, int bullets) {
+    make_start_state(level, aliens, bullets);
+
+    uint32_t steps = BENCH_STEPS / BENCH_BATCH_STEPS * BENCH_BATCH_STEPS;
+    uint64_t start = now_ns();
+    for (uint32_t done = 0; done < steps; done += BENCH_BATCH_STEPS)
+        run_batch(done);
+    uint64_t ns = now_ns() - start;
+
+    printf("game_step,%s,%s,%u,%d,%d,%lu,%lu.%03lu,%lu\n", BENCH_PLATFORM, BENCH_REVISION,
+           level, aliens, bullets, (unsigned long)steps,
+           (unsigned long)(ns / steps), (unsigned long)(ns * 1000 / steps % 1000),
+           (unsigned long)(ns ? (uint64_t)steps * 1000000000u / ns : 0));
+}
+
+int main(void) {
+
+#ifndef BENCH_HOST
+    stdio_init_all();
+    sleep_ms(2000); // tempo para o terminal USB conectar
+#endif
+
+    printf("bench,platform,revision,level,aliens,bullets,steps,ns_per_step,steps_per_s\n");
+
+    // Frota cheia, meia e um alien; sem tiros, só os do jogador e todos no ar
+    for (uint8_t level = 0; level < GAME_LEVEL_COUNT; ++level) {
+        const GameLevel_t *l = &game_levels[level];
+        int aliens = l->formation.rows * l->formation.cols;
+        int fleet_sizes[] = {aliens, aliens / 2, 1};
+        int bullet_counts[] = {0, l->player_bullets, l->player_bullets + l->enemy_bullets};
+
+        for (size_t f = 0; f < sizeof(fleet_sizes) / sizeof(fleet_sizes[0]); ++f)
+            for (size_t b = 0; b < sizeof(bullet_counts) / sizeof(bullet_counts[0]); ++b)
+                run_case(level, fleet_sizes[f], bullet_counts[b]);
+    }
+
+#ifndef BENCH_HOST
+    while (true)
+        tight_loop_contents();
+#endif
+    return 0;
+}
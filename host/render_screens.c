@@ -0,0 +1,125 @@
+/*
+ * Desenha cada tela do jogo no display em memória e grava em PBM.
+ *
+ *   render_screens [dir] [golden]
+ *
+ * Com golden, compara cada tela com a imagem de mesmo nome nesse diretório
+ * e sai com erro se algum byte diferir (teste do ctest em host/).
+ */
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_mem.h"
+#include "render.h"
+#include "alien_fleet.h"
+#include "bullet_pool.h"
+#include "game_sim.h"
+
+// Estado de jogo em andamento com a frota na posição inicial
+static void make_playing_state(GameState_t *state) {
+    memset(state, 0, sizeof(*state));
+    state->current_game_internal_state = GAME_PLAYING;
+    state->level = GAME_LEVEL_NORMAL;
+    game_sim_reset(state);
+    for (int r = 0; r < state->fleet.formation.rows; ++r)
+        for (int c = 0; c < state->fleet.formation.cols; ++c)
+            if ((r + c) % 4 == 0)
+                alien_fleet_kill(&state->fleet, r, c);
+    bullet_pool_spawn(&state->bullets, state->player_obj.x + PLAYER_WIDTH / 2, 40);
+    bullet_pool_spawn(&state->enemy_bullets, 40, 30);
+    bullet_pool_spawn(&state->enemy_bullets, 90, 45);
+    state->score = 120;
+    state->lives = 2;
+}
+
+// Nível de estresse logo no começo, com o máximo de tiros no ar
+static void make_stress_state(GameState_t *state) {
+    memset(state, 0, sizeof(*state));
+    state->current_game_internal_state = GAME_PLAYING;
+    state->level = GAME_LEVEL_STRESS;
+    game_sim_reset(state);
+    for (int i = 0; i < state->bullets.capacity; ++i)
+        bullet_pool_spawn(&state->bullets, (i * 37) % OLED_WIDTH, 52 - (i % 4) * 3);
+    for (int i = 0; i < state->enemy_bullets.capacity; ++i)
+        bullet_pool_spawn(&state->enemy_bullets, (i * 29 + 3) % OLED_WIDTH, 50 + (i % 5) * 2);
+}
+
+// Compara dois arquivos byte a byte
+static bool same_file(const char *a, const char *b) {
+    FILE *fa = fopen(a, "rb"), *fb = fopen(b, "rb");
+    bool same = fa != NULL && fb != NULL;
+    int ca, cb;
+
+    while (same) {
+        ca = fgetc(fa);
+        cb = fgetc(fb);
+        same = ca == cb;
+        if (ca == EOF)
+            break;
+    }
+    if (fa)
+        fclose(fa);
+    if (fb)
+        fclose(fb);
+    return same;
+}
+
+static bool render_to_file(ssd1306_t *oled, ssd1306_mem_t *mem, const GameState_t *state,
+                           const char *dir, const char *golden, const char *name) {
+    char path[256], golden_path[256];
+    ssd1306_stats_t stats;
+
+    render_frame(oled, state);
+    ssd1306_show(oled);
+    ssd1306_get_stats(oled, &stats);
+
+    snprintf(path, sizeof(path), "%s/%s.pbm", dir, name);
+    if (!ssd1306_mem_write_pbm(mem, path)) {
+        fprintf(stderr, "erro ao gravar %s\n", path);
+        return false;
+    }
+
+    printf("%s: %lu bytes em %lu janelas\n", path,
+           (unsigned long)stats.last_bytes, (unsigned long)stats.last_windows);
+
+    if (golden == NULL)
+        return true;
+    snprintf(golden_path, sizeof(golden_path), "%s/%s.pbm", golden, name);
+    if (!same_file(path, golden_path)) {
+        fprintf(stderr, "%s difere de %s\n", path, golden_path);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *dir = argc > 1 ? argv[1] : ".";
+    const char *golden = argc > 2 ? argv[2] : NULL;
+    ssd1306_t oled = {0};
+    ssd1306_mem_t mem;
+    GameState_t state;
+    bool ok = true;
+
+    ssd1306_mem_init(&mem);
+    if (!ssd1306_init_with_transport(&oled, &ssd1306_mem_transport, &mem))
+        return 1;
+
+    memset(&state, 0, sizeof(state));
+    state.current_game_internal_state = GAME_START_SCREEN;
+    ok &= render_to_file(&oled, &mem, &state, dir, golden, "start");
+
+    make_playing_state(&state);
+    ok &= render_to_file(&oled, &mem, &state, dir, golden, "playing");
+
+    state.current_game_internal_state = GAME_OVER;
+    ok &= render_to_file(&oled, &mem, &state, dir, golden, "game_over");
+
+    state.current_game_internal_state = GAME_WIN;
+    ok &= render_to_file(&oled, &mem, &state, dir, golden, "win");
+
+    make_stress_state(&state);
+    ok &= render_to_file(&oled, &mem, &state, dir, golden, "stress");
+
+    ssd1306_deinit(&oled);
+    return ok ? 0 : 1;
+}
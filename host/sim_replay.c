@@ -0,0 +1,176 @@
+/*
+ * Repete no host uma partida gravada no alvo (input_log.h) e mede o que o
+ * display faria com ela.
+ *
+ *   sim_replay <arquivo> [-t]
+ *
+ * O arquivo é a gravação binária ou a exportação em hexadecimal capturada
+ * da USB/UART (comando 'd'), com ou sem o resto do log em volta. Saída CSV:
+ *
+ *   replay,steps,score,lives,state,hash,frames,bytes_per_frame,ns_per_step,ns_per_frame
+ *
+ * hash resume o estado final: duas builds que repetem a partida bit a bit
+ * dão o mesmo hash. Os quadros seguem o ritmo do display (no máximo um a
+ * cada REPLAY_FRAME_STEPS passos, só quando algo mudou). Com -t, imprime o
+ * hash a cada segundo de jogo para achar onde duas builds divergem.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "ssd1306_mem.h"
+#include "render.h"
+#include "game_sim.h"
+#include "input_log.h"
+
+#define REPLAY_MAX_SIZE (1024 * 1024)
+#define REPLAY_FRAME_STEPS 3                        // ~30 quadros por segundo
+#define REPLAY_TRACE_STEPS (1000 / SIM_STEP_MS)
+
+static uint8_t data[REPLAY_MAX_SIZE];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int hex_value(int c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c = tolower(c);
+    return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+// Linha só com dígitos hexadecimais (fora os espaços do fim): bytes da exportação
+static size_t parse_hex_line(const char *line, uint8_t *dst, size_t room) {
+    size_t n = 0;
+
+    for (const char *p = line; *p && !isspace((unsigned char)*p); p += 2) {
+        int hi = hex_value(p[0]);
+        int lo = p[1] ? hex_value(p[1]) : -1;
+        if (hi < 0 || lo < 0 || n == room)
+            return 0;
+        dst[n++] = (uint8_t)(hi << 4 | lo);
+    }
+    return n;
+}
+
+static size_t load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    size_t len = 0;
+
+    if (f == NULL)
+        return 0;
+
+    len = fread(data, 1, sizeof(data), f);
+    if (len >= 4 && memcmp(data, "INP1", 4) == 0) {
+        fclose(f);
+        return len;
+    }
+
+    // Exportação em texto: as linhas entre "[INPUT] gravacao" e "[INPUT] fim"
+    static char line[256];
+    bool inside = false;
+
+    rewind(f);
+    len = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "[INPUT] gravacao", 16) == 0) {
+            inside = true;
+            len = 0;
+        } else if (strncmp(line, "[INPUT] fim", 11) == 0) {
+            inside = false;
+        } else if (inside) {
+            len += parse_hex_line(line, data + len, sizeof(data) - len);
+        }
+    }
+    fclose(f);
+    return len;
+}
+
+// FNV-1a sobre os campos do jogo, independente do layout da struct
+static uint32_t state_hash(const GameState_t *state) {
+    uint32_t h = 2166136261u;
+    uint32_t fields[] = {
+        state->step, state->rng, (uint32_t)state->score, (uint32_t)state->lives,
+        state->current_game_internal_state, state->level, (uint32_t)state->player_obj.x,
+        (uint32_t)state->fleet.x, (uint32_t)state->fleet.y, (uint32_t)state->fleet.count,
+    };
+
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i)
+        h = (h ^ fields[i]) * 16777619u;
+    for (int r = 0; r < state->fleet.formation.rows; ++r)
+        h = (h ^ state->fleet.alive[r]) * 16777619u;
+    h = (h ^ state->bullets.count) * 16777619u;
+    for (int i = 0; i < state->bullets.count; ++i)
+        h = (h ^ (uint32_t)(state->bullets.items[i].x << 8 | state->bullets.items[i].y)) * 16777619u;
+    h = (h ^ state->enemy_bullets.count) * 16777619u;
+    for (int i = 0; i < state->enemy_bullets.count; ++i)
+        h = (h ^ (uint32_t)(state->enemy_bullets.items[i].x << 8 | state->enemy_bullets.items[i].y)) * 16777619u;
+    return h;
+}
+
+int main(int argc, char **argv) {
+    static GameState_t state;
+    ssd1306_t oled = {0};
+    ssd1306_mem_t mem;
+    ssd1306_stats_t stats;
+    InputReplay replay;
+    GameInput_t input;
+
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <gravacao> [-t]\n", argv[0]);
+        return 2;
+    }
+    bool trace = argc > 2 && strcmp(argv[2], "-t") == 0;
+
+    size_t len = load(argv[1]);
+    if (!input_replay_open(&replay, data, len, &state)) {
+        fprintf(stderr, "%s: gravacao invalida\n", argv[1]);
+        return 1;
+    }
+
+    ssd1306_mem_init(&mem);
+    if (!ssd1306_init_with_transport(&oled, &ssd1306_mem_transport, &mem))
+        return 1;
+
+    uint32_t steps = 0, frames = 0, since_frame = REPLAY_FRAME_STEPS;
+    uint64_t sim_ns = 0, frame_ns = 0;
+    bool dirty = true;
+
+    if (trace)
+        printf("step,hash\n");
+
+    while (input_replay_next(&replay, &input)) {
+        uint64_t t0 = now_ns();
+        dirty |= (game_sim_step(&state, &input) & SIM_EVENT_CHANGED) != 0;
+        uint64_t t1 = now_ns();
+        sim_ns += t1 - t0;
+        steps++;
+
+        if (dirty && ++since_frame >= REPLAY_FRAME_STEPS) {
+            if (render_frame(&oled, &state))
+                ssd1306_show(&oled);
+            frame_ns += now_ns() - t1;
+            frames++;
+            since_frame = 0;
+            dirty = false;
+        }
+
+        if (trace && steps % REPLAY_TRACE_STEPS == 0)
+            printf("%lu,%08lx\n", (unsigned long)state.step, (unsigned long)state_hash(&state));
+    }
+
+    ssd1306_get_stats(&oled, &stats);
+    printf("replay,steps,score,lives,state,hash,frames,bytes_per_frame,ns_per_step,ns_per_frame\n");
+    printf("replay,%lu,%d,%d,%d,%08lx,%lu,%lu,%lu,%lu\n",
+           (unsigned long)steps, state.score, state.lives, state.current_game_internal_state,
+           (unsigned long)state_hash(&state), (unsigned long)frames,
+           (unsigned long)(frames ? stats.total_bytes / frames : 0),
+           (unsigned long)(steps ? sim_ns / steps : 0),
+           (unsigned long)(frames ? frame_ns / frames : 0));
+    return 0;
+}
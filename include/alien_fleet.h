@@ -0,0 +1,72 @@
+#ifndef ALIEN_FLEET_H
+#define ALIEN_FLEET_H
+
+#include <stdbool.h>
+#include "game_types.h"
+
+/**
+ * @brief Posiciona a frota com todos os aliens da formação vivos.
+ * @param x, y Posição do alien da linha 0, coluna 0.
+ */
+void alien_fleet_init(AlienFleet *fleet, const AlienFormation *formation, int x, int y);
+
+/**
+ * @brief Remove o alien (row, col) da frota.
+ */
+void alien_fleet_kill(AlienFleet *fleet, int row, int col);
+
+/**
+ * @brief Acerta o alien que cobre o ponto (x, y), se houver.
+ *
+ * Uma subtração e uma divisão por eixo acham a célula da grade; o resto da
+ * divisão diz se o ponto caiu no alien ou no espaço entre eles, e um bit
+ * diz se ele está vivo. Se as fileiras se sobrepõem, as de cima que cobrem
+ * o ponto também são testadas, de baixo para cima. O alien acertado é
+ * removido.
+ *
+ * @return true se algum alien foi acertado.
+ */
+bool alien_fleet_hit(AlienFleet *fleet, int x, int y);
+
+static inline bool alien_fleet_alive(const AlienFleet *fleet, int row, int col) {
+    return (fleet->alive[row] >> col) & 1;
+}
+
+static inline int alien_fleet_slot_x(const AlienFleet *fleet, int col) {
+    return fleet->x + col * fleet->formation.spacing_x;
+}
+
+static inline int alien_fleet_slot_y(const AlienFleet *fleet, int row) {
+    return fleet->y + row * fleet->formation.spacing_y;
+}
+
+/**
+ * @brief Move a formação inteira: só a origem muda, qualquer que seja o tamanho da frota.
+ */
+static inline void alien_fleet_move(AlienFleet *fleet, int dx, int dy) {
+    fleet->x += dx;
+    fleet->y += dy;
+}
+
+// Extremos da frota viva na tela; só valem com fleet->count > 0
+static inline int alien_fleet_left(const AlienFleet *fleet) {
+    return fleet->x + fleet->left;      // primeira coluna de pixels
+}
+
+static inline int alien_fleet_right(const AlienFleet *fleet) {
+    return fleet->x + fleet->right;     // coluna seguinte à última
+}
+
+static inline int alien_fleet_bottom(const AlienFleet *fleet) {
+    return fleet->y + fleet->bottom;    // linha seguinte à última
+}
+
+/**
+ * @brief Linha do alien vivo mais de baixo da coluna, o que pode atirar.
+ * @return -1 se a coluna está vazia.
+ */
+static inline int alien_fleet_shooter_row(const AlienFleet *fleet, int col) {
+    return fleet->column_rows[col] ? 31 - __builtin_clz(fleet->column_rows[col]) : -1;
+}
+
+#endif
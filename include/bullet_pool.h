@@ -0,0 +1,38 @@
+#ifndef BULLET_POOL_H
+#define BULLET_POOL_H
+
+#include <stddef.h>
+#include "game_types.h"
+
+/**
+ * @brief Esvazia o pool e define quantos tiros o nível permite no ar.
+ */
+static inline void bullet_pool_init(BulletPool *pool, uint8_t capacity) {
+    pool->count = 0;
+    pool->capacity = capacity < BULLET_POOL_MAX ? capacity : BULLET_POOL_MAX;
+}
+
+/**
+ * @brief Cria um tiro em (x, y) na primeira vaga livre, em O(1).
+ * @return O tiro criado, ou NULL se o nível já tem o máximo no ar.
+ */
+static inline GameObject *bullet_pool_spawn(BulletPool *pool, int x, int y) {
+    if (pool->count >= pool->capacity)
+        return NULL;
+
+    GameObject *bullet = &pool->items[pool->count++];
+    bullet->x = x;
+    bullet->y = y;
+    bullet->active = true;
+    return bullet;
+}
+
+/**
+ * @brief Remove o tiro i trazendo o último para o lugar dele, em O(1).
+ * @note Quem remove dentro de um laço deve percorrer o pool de trás para frente.
+ */
+static inline void bullet_pool_despawn(BulletPool *pool, int i) {
+    pool->items[i] = pool->items[--pool->count];
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#define DISPLAY_LIST_MAX_NODES 232  // objetos desenhados em uma tela (o nível de estresse usa 227)
+#define DISPLAY_LIST_MAX_RECTS 8    // retângulos sujos por quadro; acima disso redesenha tudo
+#define DISPLAY_LIST_TEXT_LEN 24    // tamanho máximo de um texto, com o '\0'
+
+typedef enum {
+    DL_NODE_SPRITE,
+    DL_NODE_TEXT,
+    DL_NODE_IMAGE
+} DisplayNodeKind_e;
+
+// Retângulo na tela: [x0, x1) x [y0, y1)
+typedef struct {
+    int16_t x0, y0;
+    int16_t x1, y1;
+} DisplayRect;
+
+typedef struct {
+    DisplayNodeKind_e kind;
+    int16_t x, y;
+    bool visible;
+    bool changed;                       // alterado desde o último quadro
+    const ssd1306_sprite_t *sprite;
+    const ssd1306_image_t *image;
+    const ssd1306_font_t *font;
+    char text[DISPLAY_LIST_TEXT_LEN];
+
+    bool drawn;                         // está no framebuffer
+    DisplayRect drawn_rect;             // área ocupada no framebuffer
+} DisplayNode;
+
+/**
+ * @brief Lista de objetos retida entre quadros.
+ *
+ * Cada quadro só apaga e redesenha as áreas dos nós que mudaram, e os
+ * retângulos sujos são repassados ao ssd1306_show para limitar o diff.
+ * Todo o conteúdo do framebuffer deve vir de nós da lista.
+ */
+typedef struct {
+    DisplayNode nodes[DISPLAY_LIST_MAX_NODES];
+    uint8_t count;
+    bool full_redraw;                   // próximo quadro redesenha a tela inteira
+    DisplayRect rects[DISPLAY_LIST_MAX_RECTS];
+    uint8_t rect_count;                 // retângulos sujos do último quadro
+} DisplayList;
+
+/**
+ * @brief Esvazia a lista e agenda o redesenho completo (troca de tela).
+ */
+void display_list_reset(DisplayList *dl);
+
+/**
+ * @brief Adiciona um sprite, desenhado em modo transparente.
+ *
+ * @return Índice do nó, ou -1 se a lista estiver cheia.
+ */
+int display_list_add_sprite(DisplayList *dl, const ssd1306_sprite_t *sprite, int16_t x, int16_t y, bool visible);
+
+/**
+ * @brief Adiciona um texto com uma fonte compilada.
+ *
+ * @return Índice do nó, ou -1 se a lista estiver cheia.
+ */
+int display_list_add_text(DisplayList *dl, const ssd1306_font_t *font, int16_t x, int16_t y, const char *text);
+
+/**
+ * @brief Adiciona uma imagem desenhada em modo opaco (cópia em bloco).
+ *
+ * Por ser opaca, deve ser adicionada antes dos nós que podem passar por cima.
+ *
+ * @return Índice do nó, ou -1 se a lista estiver cheia.
+ */
+int display_list_add_image(DisplayList *dl, const ssd1306_image_t *image, int16_t x, int16_t y);
+
+/**
+ * @brief Marca um nó para redesenho, quando o conteúdo apontado por ele mudou.
+ */
+void display_list_touch(DisplayList *dl, int node);
+
+/**
+ * @brief Move e mostra/esconde um nó; só marca o nó se algo mudou.
+ */
+void display_list_set(DisplayList *dl, int node, int16_t x, int16_t y, bool visible);
+
+/**
+ * @brief Esconde um nó no lugar onde está.
+ */
+void display_list_hide(DisplayList *dl, int node);
+
+/**
+ * @brief Troca o texto de um nó de texto; só marca o nó se o texto mudou.
+ */
+void display_list_set_text(DisplayList *dl, int node, const char *text);
+
+/**
+ * @brief Atualiza o framebuffer com os nós que mudaram.
+ *
+ * Apaga as áreas antigas e novas dos nós alterados, redesenha os nós que
+ * tocam essas áreas e informa os retângulos com ssd1306_add_damage.
+ *
+ * @return Número de retângulos sujos (0 se nada mudou).
+ */
+uint8_t display_list_render(DisplayList *dl, ssd1306_t *oled);
+
+#endif
@@ -4,66 +4,51 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "FreeRTOS.h"
-#include "semphr.h"
+#include "event_groups.h"
 #include "ssd1306.h"
+#include "game_types.h"
 
-// Definições de dimensões e constantes do jogo
-#define OLED_WIDTH 128
-#define OLED_HEIGHT 64
-#define PLAYER_WIDTH 5
-#define PLAYER_HEIGHT 8
-#define PLAYER_Y_POS (OLED_HEIGHT - PLAYER_HEIGHT + 5)
-#define ALIEN_WIDTH 5
-#define ALIEN_HEIGHT 8
-#define MAX_PLAYER_BULLETS 1
-#define MAX_ENEMY_BULLETS 4
-#define NUM_ALIEN_ROWS 2
-#define NUM_ALIEN_COLS 10
+// Variáveis globais externas
+extern ssd1306_t oled_display;          // Instância do display OLED
+extern GameState_t g_game_state;        // Estado do jogo, alterado só pela task de simulação
+extern EventGroupHandle_t g_game_events;     // Eventos da lógica do jogo para o display
+
+#define GAME_EVENT_STATE_CHANGED (1 << 0)    // O estado do jogo mudou e a tela precisa ser redesenhada
+#define GAME_EVENT_REPLAY_REQUEST (1 << 1)   // A simulação deve repetir a partida gravada
 
 /**
- * @brief Enumeração dos estados internos do jogo.
+ * @brief Publica g_game_state para o display e o acorda.
+ *
+ * O display copia a última publicação sem travas (game_snapshot.h), então
+ * a simulação nunca espera pelo desenho de um quadro.
+ * @note Só a task de simulação (a única que escreve no estado) deve chamar.
  */
-typedef enum {
-    GAME_START_SCREEN,  // Tela inicial
-    GAME_PLAYING,       // Jogo em andamento
-    GAME_OVER,          // Fim de jogo por derrota
-    GAME_WIN            // Fim de jogo por vitória
-} GameInternalState_e;
+void game_state_publish(void);
 
 /**
- * @brief Estrutura para representar um objeto no jogo (jogador, alien, tiro).
+ * @brief Acorda a task do display sem publicar um estado novo.
+ * @note Sem esse aviso (ou game_state_publish) a tela não é redesenhada.
  */
-typedef struct {
-    int x, y;       // Posição do objeto
-    bool active;    // Status do objeto (ativo ou inativo)
-} GameObject;
+void game_state_changed(void);
 
 /**
- * @brief Estrutura principal que contém todo o estado do jogo.
+ * @brief Pede à task de simulação para repetir a última partida gravada.
+ *
+ * As entradas gravadas substituem joystick e botão até o fim da gravação;
+ * quadros e tempos de envio se repetem a cada replay.
  */
-typedef struct {
-    GameObject player_obj;                                  // Objeto do jogador
-    GameObject bullets[MAX_PLAYER_BULLETS];                 // Tiros do jogador
-    GameObject aliens[NUM_ALIEN_ROWS][NUM_ALIEN_COLS];      // Frota de aliens
-    GameObject enemy_bullets[MAX_ENEMY_BULLETS];            // Tiros dos inimigos
-    int score;                                              // Pontuação atual
-    int lives;                                              // Vidas restantes do jogador
-    GameInternalState_e current_game_internal_state;        // Estado atual do jogo
-    int alien_dx;                                           // Direção do movimento dos aliens
-    uint32_t last_alien_move_time;                          // Tempo do último movimento dos aliens
-    uint32_t current_alien_move_speed_ms;                   // Velocidade de movimento dos aliens
-    uint32_t last_enemy_shot_decision_time;                 // Tempo da última decisão de tiro inimigo
-} GameState_t;
+void sim_replay_request(void);
 
-// Variáveis globais externas
-extern ssd1306_t oled_display;          // Instância do display OLED
-extern GameState_t g_game_state;        // Instância global do estado do jogo
-extern SemaphoreHandle_t g_game_state_mutex; // Mutex para proteger o acesso ao estado do jogo
+/**
+ * @brief Acorda a task de simulação, que dorme fora da partida.
+ * @note Quem muda algo que ela consulta antes de dormir (pedido de replay) deve chamar.
+ */
+void sim_wake(void);
 
 /**
- * @brief Inicializa/reseta os dados do jogo para um novo começo.
- * @note Esta função não é segura para threads e deve ser chamada dentro de uma seção crítica (protegida por mutex).
+ * @brief Imprime a gravação das entradas (input_log.h) em hexadecimal na USB/UART.
+ * @note Exportar no meio de uma partida encerra a gravação dela.
  */
-void initialize_game_data_unsafe(void);
+void sim_input_log_export(void);
 
 #endif
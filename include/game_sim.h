@@ -0,0 +1,87 @@
+#ifndef GAME_SIM_H
+#define GAME_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game_types.h"
+
+// Passo fixo da simulação; as demais taxas são divisores dele
+#define SIM_STEP_MS 10
+#define SIM_PLAYER_DIVISOR 2        // jogador a cada 2 passos (20 ms)
+#define SIM_BULLET_DIVISOR 3        // tiros a cada 3 passos (30 ms)
+#define SIM_ALIEN_DIVISOR 5         // frota a cada 5 passos (50 ms)
+#define SIM_MAX_CATCHUP_STEPS 4     // passos por chamada de game_step quando atrasa; o resto é descartado
+
+// Eventos de saída de um passo, para quem toca sons, acende o LED e redesenha.
+// A simulação não depende de FreeRTOS nem do hardware: só devolve os eventos.
+#define SIM_EVENT_CHANGED (1u << 0)         // algo visível mudou
+#define SIM_EVENT_GAME_START (1u << 1)      // partida nova começou
+#define SIM_EVENT_PLAYER_SHOOT (1u << 2)
+#define SIM_EVENT_ALIEN_HIT (1u << 3)
+#define SIM_EVENT_PLAYER_HIT (1u << 4)
+#define SIM_EVENT_GAME_OVER (1u << 5)
+#define SIM_EVENT_GAME_WIN (1u << 6)
+
+/**
+ * @brief Níveis em game_levels: tamanho da frota e tiros simultâneos.
+ */
+typedef enum {
+    GAME_LEVEL_NORMAL,      // Frota 2x10, 1 tiro do jogador e 4 dos aliens
+    GAME_LEVEL_STRESS,      // Frota 8x16 e 64 tiros, para medir o orçamento do quadro
+    GAME_LEVEL_COUNT
+} GameLevel_e;
+
+extern const GameLevel_t game_levels[GAME_LEVEL_COUNT];
+
+/**
+ * @brief Entradas do jogador amostradas para um passo.
+ */
+typedef struct {
+    int8_t move;    // -1 esquerda, 0 parado, 1 direita
+    bool fire;      // botão de tiro pressionado
+} GameInput_t;
+
+/**
+ * @brief Semeia o gerador pseudoaleatório da simulação (tiros dos aliens).
+ *
+ * Mesma semente e mesmas entradas, mesma partida, em qualquer plataforma.
+ */
+void game_sim_seed(GameState_t *state, uint32_t seed);
+
+/**
+ * @brief Começa uma partida nova no nível state->level (jogador, frota, tiros, score e vidas).
+ * @note Não muda a tela atual, o contador de passos, o nível nem o gerador:
+ *       com eles e o botão de tiro, o estado na tela inicial define a partida inteira.
+ */
+void game_sim_reset(GameState_t *state);
+
+/**
+ * @brief Avança a simulação um passo de SIM_STEP_MS.
+ *
+ * Ordem fixa: entrada -> tiros -> frota -> colisões -> vitória/derrota.
+ * Cada etapa roda nos passos múltiplos do seu divisor.
+ *
+ * @return Máscara de SIM_EVENT_*.
+ */
+uint32_t game_sim_step(GameState_t *state, const GameInput_t *input);
+
+/**
+ * @brief Acumula dt_ms de tempo real e devolve quantos passos rodar agora.
+ *
+ * No máximo SIM_MAX_CATCHUP_STEPS; o atraso além disso é descartado. Para
+ * quem alimenta cada passo com uma entrada própria (replay).
+ */
+uint32_t game_sim_steps_due(GameState_t *state, uint32_t dt_ms);
+
+/**
+ * @brief Avança a simulação dt_ms de tempo real.
+ *
+ * Acumula o tempo e roda os passos de SIM_STEP_MS que couberem, no máximo
+ * SIM_MAX_CATCHUP_STEPS; o atraso além disso é descartado. Todos os passos
+ * usam a mesma entrada.
+ *
+ * @return Máscara de SIM_EVENT_* dos passos executados.
+ */
+uint32_t game_step(GameState_t *state, const GameInput_t *input, uint32_t dt_ms);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <stdint.h>
+#include "game_types.h"
+
+/**
+ * @brief Publica uma cópia do estado do jogo para os leitores (display).
+ *
+ * Duas cópias alternadas sob um contador de sequência (seqlock): a nova
+ * cópia é escrita na que não está publicada e só então o contador avança.
+ * Não bloqueia nem depende do FreeRTOS.
+ *
+ * @note Um único escritor: só a task de simulação publica, e o contador de
+ *       sequência é a única sincronização (não há mutex do jogo).
+ */
+void game_snapshot_publish(const GameState_t *state);
+
+/**
+ * @brief Copia o último estado publicado, sem travas.
+ *
+ * Se uma publicação terminar durante a cópia ela é refeita; o escritor
+ * nunca espera pelo leitor.
+ *
+ * @param out Destino da cópia.
+ * @return Número de sequência da cópia (cresce a cada publicação).
+ */
+uint32_t game_snapshot_read(GameState_t *out);
+
+#endif
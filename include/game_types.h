@@ -0,0 +1,119 @@
+#ifndef GAME_TYPES_H
+#define GAME_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_panel.h"
+
+// Definições de dimensões e constantes do jogo; a tela vem do painel escolhido no build
+#define OLED_WIDTH SSD1306_WIDTH
+#define OLED_HEIGHT SSD1306_HEIGHT
+#define PLAYER_WIDTH 5
+#define PLAYER_HEIGHT 8
+#define PLAYER_Y_POS (OLED_HEIGHT - PLAYER_HEIGHT + 5)
+#define ALIEN_WIDTH 5
+#define ALIEN_HEIGHT 8
+
+// Capacidade das estruturas do estado (memória estática); cada nível usa até
+// esses limites (game_levels, em game_sim.c)
+#define ALIEN_MAX_ROWS 8
+#define ALIEN_MAX_COLS 16
+#define BULLET_POOL_MAX 48                  // tiros por pool (jogador ou aliens)
+
+_Static_assert(ALIEN_MAX_COLS <= 32 && ALIEN_MAX_ROWS <= 32, "a frota usa máscaras de 32 bits");
+_Static_assert(BULLET_POOL_MAX <= 255, "o pool conta os tiros em 8 bits");
+
+/**
+ * @brief Enumeração dos estados internos do jogo.
+ */
+typedef enum {
+    GAME_START_SCREEN,  // Tela inicial
+    GAME_PLAYING,       // Jogo em andamento
+    GAME_OVER,          // Fim de jogo por derrota
+    GAME_WIN            // Fim de jogo por vitória
+} GameInternalState_e;
+
+/**
+ * @brief Estrutura para representar um objeto no jogo (jogador, alien, tiro).
+ */
+typedef struct {
+    int x, y;       // Posição do objeto
+    bool active;    // Status do objeto (ativo ou inativo)
+} GameObject;
+
+/**
+ * @brief Grade da frota de um nível.
+ */
+typedef struct {
+    uint8_t rows, cols;                     // Até ALIEN_MAX_ROWS x ALIEN_MAX_COLS
+    uint8_t spacing_x, spacing_y;           // Distância entre colunas e entre linhas
+} AlienFormation;
+
+/**
+ * @brief Frota de aliens em formação, com os vivos em máscaras de bits.
+ *
+ * Só a origem (x, y) se move; o alien (r, c) fica na origem mais o
+ * deslocamento fixo da sua vaga, (c * spacing_x, r * spacing_y).
+ * As máscaras por linha e por coluna guardam a mesma informação: cada uma
+ * responde em O(1) a uma pergunta diferente (ver alien_fleet.h). Os
+ * extremos da frota viva, relativos à origem, só mudam quando um alien morre.
+ */
+typedef struct {
+    AlienFormation formation;               // Grade do nível atual
+    int x, y;                               // Origem da formação (vaga da linha 0, coluna 0)
+    int16_t left, right, bottom;            // Extremos da frota viva relativos à origem: [left, right), até bottom
+    uint32_t alive[ALIEN_MAX_ROWS];         // Bit c: alien da coluna c vivo nesta linha
+    uint32_t column_rows[ALIEN_MAX_COLS];   // Bit r: alien da linha r vivo nesta coluna
+    uint32_t columns;                       // Bit c: coluna c com algum alien vivo
+    uint32_t rows;                          // Bit r: linha r com algum alien vivo
+    int count;                              // Aliens vivos
+} AlienFleet;
+
+/**
+ * @brief Tiros no ar, densos no começo do vetor.
+ *
+ * Os ativos ficam em items[0, count) e as vagas livres em [count, capacity):
+ * criar é escrever em items[count], remover é trazer o último para o lugar
+ * do removido, e percorrer custa só os ativos (ver bullet_pool.h).
+ */
+typedef struct {
+    GameObject items[BULLET_POOL_MAX];
+    uint8_t count;                          // Tiros ativos
+    uint8_t capacity;                       // Limite do nível, até BULLET_POOL_MAX
+} BulletPool;
+
+/**
+ * @brief Tamanho de um nível: frota e tiros simultâneos.
+ */
+typedef struct {
+    AlienFormation formation;
+    int16_t fleet_x, fleet_y;               // Posição inicial da formação
+    uint8_t player_bullets;                 // Tiros do jogador no ar ao mesmo tempo
+    uint8_t enemy_bullets;                  // Tiros dos aliens no ar ao mesmo tempo
+} GameLevel_t;
+
+/**
+ * @brief Estrutura principal que contém todo o estado do jogo.
+ */
+typedef struct {
+    GameObject player_obj;                                  // Objeto do jogador
+    BulletPool bullets;                                     // Tiros do jogador
+    AlienFleet fleet;                                       // Frota de aliens
+    BulletPool enemy_bullets;                               // Tiros dos inimigos
+    uint8_t level;                                          // Índice em game_levels da partida atual
+    int score;                                              // Pontuação atual
+    int lives;                                              // Vidas restantes do jogador
+    GameInternalState_e current_game_internal_state;        // Estado atual do jogo
+    int alien_dx;                                           // Direção do movimento dos aliens
+    bool alien_move_down_next;                              // O próximo movimento da frota é para baixo
+    uint32_t current_alien_move_speed_ms;                   // Intervalo entre movimentos dos aliens
+    uint32_t step;                                          // Passos de simulação desde o boot
+    uint32_t last_alien_move_step;                          // Passo do último movimento dos aliens
+    uint32_t last_enemy_shot_step;                          // Passo da última decisão de tiro inimigo
+    uint32_t last_player_shot_step;                         // Passo do último tiro do jogador
+    bool fire_held;                                         // Botão de tiro no último passo do jogador
+    uint32_t step_accum_ms;                                 // Tempo recebido por game_step ainda sem passo
+    uint32_t rng;                                           // Estado do gerador pseudoaleatório (xorshift32)
+} GameState_t;
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#define HUD_FIELD_MAX_WIDTH 64  // colunas de um campo (rótulo + dígitos)
+#define HUD_MAX_DIGITS 10       // dígitos de um uint32_t
+
+/**
+ * @brief Campo numérico do HUD ("Score: 120") pré-renderizado em uma página.
+ *
+ * O rótulo é desenhado uma vez; a cada valor novo só os dígitos que mudaram
+ * são redesenhados, em células de largura fixa. A imagem resultante é
+ * copiada inteira para o framebuffer (ssd1306_draw_image em modo opaco).
+ */
+typedef struct {
+    uint8_t data[HUD_FIELD_MAX_WIDTH];  // página de 8 linhas do campo
+    ssd1306_image_t image;              // aponta para data
+    const ssd1306_font_t *font;
+    uint8_t digits_x;                   // coluna da primeira célula de dígito
+    uint8_t cell_width;                 // largura de cada célula de dígito
+    uint8_t digits;                     // número de células
+    char shown[HUD_MAX_DIGITS];         // dígito desenhado em cada célula, ' ' se vazia
+    uint32_t value;
+} HudField;
+
+/**
+ * @brief Escreve os dígitos decimais de value em dst, sem '\0'.
+ *
+ * @return Número de dígitos escritos (1 a HUD_MAX_DIGITS).
+ */
+uint8_t hud_format_uint(char *dst, uint32_t value);
+
+/**
+ * @brief Prepara o campo com o rótulo e as células vazias.
+ *
+ * @param font Fonte de até 8 pixels de altura.
+ * @param label Texto fixo antes do número (ex.: "Score: ").
+ * @param digits Células de dígito; valores maiores ficam saturados em 9...9.
+ */
+void hud_field_init(HudField *field, const ssd1306_font_t *font, const char *label, uint8_t digits);
+
+/**
+ * @brief Atualiza o valor do campo, redesenhando só as células alteradas.
+ *
+ * @return true se a imagem do campo mudou.
+ */
+bool hud_field_set(HudField *field, uint32_t value);
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "game_types.h"
+#include "game_sim.h"
+
+/*
+ * Gravação das entradas de uma partida, para repeti-la passo a passo.
+ *
+ * Formato (little-endian):
+ *
+ *   cabeçalho, INPUT_LOG_HEADER_SIZE bytes:
+ *     "INP1", passo (u32), gerador (u32), botão de tiro segurado (u8), nível (u8),
+ *     2 bytes zerados
+ *   um byte por sequência de passos com a mesma entrada:
+ *     bits 0-1 movimento + 1, bit 2 tiro, bits 3-7 passos - 1 (até 32)
+ *
+ * O cabeçalho é o estado da simulação na tela inicial, logo antes do passo
+ * que começa a partida: nessa tela só o passo, o gerador, o botão e o nível
+ * importam para o que vem depois, então a mesma semente e as mesmas entradas
+ * repetem a partida bit a bit, no alvo ou no host.
+ */
+
+#define INPUT_LOG_HEADER_SIZE 16
+#define INPUT_LOG_MAX_RUN 32
+
+/**
+ * @brief Gravador em um buffer de RAM fornecido por quem chama.
+ *
+ * Quando o buffer enche a gravação para: o começo é o que permite repetir
+ * a partida, então não é sobrescrito.
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;                             // Bytes gravados, cabeçalho incluído (0: nada gravado)
+    bool full;                              // Buffer cheio, passos seguintes descartados
+    volatile bool frozen;                   // Exportando: gravação suspensa
+    uint8_t armed[INPUT_LOG_HEADER_SIZE];   // Cabeçalho da próxima partida
+} InputLog;
+
+/**
+ * @brief Leitor de uma gravação, um passo por vez.
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    uint32_t run;           // Passos restantes com a entrada atual
+    GameInput_t input;
+} InputReplay;
+
+void input_log_init(InputLog *log, uint8_t *buf, size_t size);
+
+/**
+ * @brief Guarda o estado atual como início da próxima partida gravada.
+ * @note Chamar na tela inicial, antes dos passos em que o jogo pode começar.
+ */
+void input_log_arm(InputLog *log, const GameState_t *state);
+
+/**
+ * @brief Descarta a gravação anterior e começa uma nova a partir do último input_log_arm.
+ */
+void input_log_begin(InputLog *log);
+
+/**
+ * @brief Grava `steps` passos com a mesma entrada.
+ */
+void input_log_record(InputLog *log, const GameInput_t *input, uint32_t steps);
+
+/**
+ * @brief Abre uma gravação e monta o estado em que ela começa.
+ * @return false se os dados não são uma gravação.
+ */
+bool input_replay_open(InputReplay *replay, const uint8_t *data, size_t len, GameState_t *state);
+
+/**
+ * @brief Entrada do próximo passo.
+ * @return false no fim da gravação.
+ */
+bool input_replay_next(InputReplay *replay, GameInput_t *input);
+
+#endif
@@ -10,6 +10,8 @@ extern volatile bool g_game_paused;
 
 /**
  * @brief Task que monitora o botão de pausa e atualiza a flag g_game_paused.
+ *
+ * Dorme até a interrupção do botão e descarta os repiques antes de trocar a flag.
  * 
  * @param pv Parâmetros da task (não utilizado).
  */
@@ -0,0 +1,25 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "ssd1306.h"
+#include "game_types.h"
+
+/**
+ * @brief Atualiza no buffer do display a tela correspondente ao estado do jogo.
+ *
+ * Os objetos ficam retidos entre quadros: só as áreas que mudaram são
+ * apagadas e redesenhadas, e informadas ao display com ssd1306_add_damage.
+ * Não depende do FreeRTOS: o chamador deve garantir acesso exclusivo ao estado.
+ *
+ * @param oled Display de destino; o buffer só pode ser alterado pelo renderizador.
+ * @param state Estado do jogo a ser desenhado.
+ * @return true se o buffer mudou e precisa ser enviado.
+ */
+bool render_frame(ssd1306_t *oled, const GameState_t *state);
+
+/**
+ * @brief Força o redesenho completo da tela no próximo render_frame.
+ */
+void render_invalidate(void);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SCREEN_FX_H
+#define SCREEN_FX_H
+
+#include <stdbool.h>
+#include "ssd1306.h"
+#include "game_types.h"
+
+#define SCREEN_FX_STARFIELD_PAGES 2    // páginas de baixo da tela inicial roladas pelo scroll
+#define SCREEN_FX_STARFIELD_Y (OLED_HEIGHT - 8 * SCREEN_FX_STARFIELD_PAGES)
+
+/**
+ * @brief Atualiza os efeitos feitos pelo próprio controlador do display.
+ *
+ * Transição entre telas e tremida ao perder vida mudam a linha inicial do
+ * display; o campo de estrelas da tela inicial usa o scroll horizontal.
+ * Nenhum deles altera o framebuffer nem gera envio de dados.
+ *
+ * Deve ser chamada a cada quadro, depois de render_frame e antes de
+ * ssd1306_show_async, com o barramento livre.
+ *
+ * @param screen Tela atual do jogo.
+ * @param lives Vidas atuais do jogador.
+ * @return true enquanto algum efeito precisa de mais quadros.
+ */
+bool screen_fx_update(ssd1306_t *oled, GameInternalState_e screen, int lives);
+
+#endif
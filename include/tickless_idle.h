@@ -0,0 +1,21 @@
+#ifndef TICKLESS_IDLE_H
+#define TICKLESS_IDLE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Prepara o alarme do timer que acorda o RP2040 do idle sem tick.
+ *
+ * Com configUSE_TICKLESS_IDLE, quando todas as tasks estão bloqueadas o
+ * SysTick é parado e o núcleo dorme em WFI até o alarme (a próxima task a
+ * acordar) ou qualquer outra interrupção (botão, USB, DMA do display).
+ * @note Chamar antes de vTaskStartScheduler.
+ */
+void tickless_idle_init(void);
+
+/**
+ * @brief Tempo total dormindo em WFI desde o boot, em microssegundos.
+ */
+uint64_t tickless_idle_slept_us(void);
+
+#endif
@@ -30,8 +30,14 @@ SOFTWARE.
 
 #ifndef _inc_ssd1306
 #define _inc_ssd1306
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306_panel.h"
+#ifndef SSD1306_HOST
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
+#endif
 
 /**
 *	@brief defines commands used in ssd1306
@@ -53,29 +59,231 @@ typedef enum {
     SET_DISP_CLK_DIV = 0xD5,
     SET_PRECHARGE = 0xD9,
     SET_VCOM_DESEL = 0xDB,
-    SET_CHARGE_PUMP = 0x8D
+    SET_CHARGE_PUMP = 0x8D,
+    SET_HSCROLL_RIGHT = 0x26,
+    SET_HSCROLL_LEFT = 0x27,
+    SET_VHSCROLL_RIGHT = 0x29,
+    SET_VHSCROLL_LEFT = 0x2A,
+    SET_SCROLL_OFF = 0x2E,
+    SET_SCROLL_ON = 0x2F,
+    SET_VSCROLL_AREA = 0xA3
 } ssd1306_command_t;
 
 /**
-*	@brief holds the configuration
+*	@brief raster operation applied by the primitives that take one
+*/
+typedef enum {
+    SSD1306_ROP_OR,		/**< set pixels */
+    SSD1306_ROP_AND,	/**< clear pixels (buffer AND NOT shape) */
+    SSD1306_ROP_XOR		/**< invert pixels */
+} ssd1306_rop_t;
+
+/**
+*	@brief how a sprite is combined with the buffer
+*/
+typedef enum {
+    SSD1306_SPRITE_TRANSPARENT,	/**< only set pixels are drawn */
+    SSD1306_SPRITE_OPAQUE		/**< the sprite's bounding box replaces the buffer */
+} ssd1306_sprite_mode_t;
+
+/**
+*	@brief direction of the continuous hardware scroll
+*/
+typedef enum {
+    SSD1306_SCROLL_RIGHT,	/**< content moves right */
+    SSD1306_SCROLL_LEFT		/**< content moves left */
+} ssd1306_scroll_dir_t;
+
+/**
+*	@brief time between two scroll steps, in frames of the controller (values as sent to it)
+*/
+typedef enum {
+    SSD1306_SCROLL_2_FRAMES=7,
+    SSD1306_SCROLL_3_FRAMES=4,
+    SSD1306_SCROLL_4_FRAMES=5,
+    SSD1306_SCROLL_5_FRAMES=0,
+    SSD1306_SCROLL_25_FRAMES=6,
+    SSD1306_SCROLL_64_FRAMES=1,
+    SSD1306_SCROLL_128_FRAMES=2,
+    SSD1306_SCROLL_256_FRAMES=3
+} ssd1306_scroll_speed_t;
+
+/**
+*	@brief sprite in page format with its eight vertical shifts precomputed
+
+	copy k holds the sprite moved down by k pixels, stride pages of width bytes each
+*/
+typedef struct {
+    uint8_t width;		/**< width in pixels */
+    uint8_t height;		/**< height in pixels */
+    uint8_t stride;		/**< pages per shifted copy */
+    const uint8_t *data;	/**< eight shifted copies, stride*width bytes each */
+} ssd1306_sprite_t;
+
+/**
+*	@brief image in page format, as produced by tools/asset_compiler.py
+
+	page k holds rows 8k..8k+7 as width bytes, LSB on top
+*/
+typedef struct {
+    uint8_t width;		/**< width in pixels */
+    uint8_t height;		/**< height in pixels */
+    const uint8_t *data;	/**< (height+7)/8 pages of width bytes */
+} ssd1306_image_t;
+
+/**
+*	@brief compiled font, as produced by tools/font_compiler.py
+
+	glyphs are stored as columns of pages bytes, LSB on top, each glyph only as wide as its ink
+*/
+typedef struct {
+    uint8_t height;		/**< glyph height in pixels */
+    uint8_t pages;		/**< bytes per glyph column, (height+7)/8 */
+    uint8_t spacing;		/**< blank columns after each glyph */
+    uint8_t first;		/**< first character in the font */
+    uint8_t last;		/**< last character in the font */
+    const uint8_t *widths;	/**< width in columns of each glyph */
+    const uint16_t *offsets;	/**< offset of each glyph in data */
+    const uint8_t *data;	/**< glyph columns */
+} ssd1306_font_t;
+
+/**
+*	@brief bytes of packed transactions needed for a frame
+
+	every address window covers at least one page and adds at most 8 bytes of commands and control bytes
+*/
+#define SSD1306_TXSIZE (SSD1306_BUFSIZE+8*SSD1306_PAGES)
+
+/**
+*	@brief bytes of storage needed by ssd1306_sprite_init
+*/
+#define SSD1306_SPRITE_STORAGE_SIZE(width, height) (8*((((height)+7)/8)+1)*(width))
+
+/**
+*	@brief transfer statistics collected by ssd1306_show
+*/
+typedef struct {
+    uint32_t frames;		/**< number of calls to ssd1306_show */
+    uint32_t last_bytes;	/**< bytes sent by the last ssd1306_show (commands and data) */
+    uint32_t last_windows;	/**< address windows sent by the last ssd1306_show */
+    uint32_t total_bytes;	/**< bytes sent since the last reset */
+    uint32_t last_bus_us;	/**< bus time of the last frame in microseconds */
+    uint32_t total_bus_us;	/**< bus time since the last reset in microseconds */
+} ssd1306_stats_t;
+
+/**
+*	@brief called from interrupt context when an asynchronous transfer finished
+*/
+typedef void (*ssd1306_done_cb_t)(void *ctx);
+
+/**
+*	@brief called while a blocking call waits for an asynchronous transfer, see ssd1306_set_wait_callback
+*/
+typedef void (*ssd1306_wait_cb_t)(void *ctx);
+
+/**
+*	@brief moves bytes to the display
+
+	a frame is a list of transactions packed back to back, each starting with
+	its control byte (0x00 commands, 0x40 data)
+*/
+typedef struct {
+    /** send one transaction and wait for it, false on bus error */
+    bool (*write)(void *ctx, const uint8_t *src, size_t len);
+    /** optional: start sending xfers transactions (transaction i ends at src+end[i]) and return,
+        ssd1306_transfer_done must be called when they are out. false if not possible right now */
+    bool (*write_async)(void *ctx, const uint8_t *src, const uint16_t *end, uint16_t xfers);
+    /** optional: wait until everything queued has left the bus */
+    void (*wait_idle)(void *ctx);
+    /** optional: release resources, called by ssd1306_deinit */
+    void (*deinit)(void *ctx);
+} ssd1306_transport_t;
+
+#ifndef SSD1306_HOST
+struct ssd1306;
+
+/**
+*	@brief bus errors counted by the i2c transport
+*/
+typedef struct {
+    uint32_t nacks;		/**< transfers not acknowledged by the display */
+    uint32_t timeouts;	/**< transfers that did not leave the bus in time */
+    uint32_t aborts;	/**< transfers aborted by the controller for another reason */
+    uint32_t recoveries;	/**< bus recoveries (SCL clocking and controller re-init) */
+} ssd1306_i2c_errors_t;
+
+/**
+*	@brief context of the built-in i2c transport
 */
 typedef struct {
-    uint8_t width; 		/**< width of display */
-    uint8_t height; 	/**< height of display */
-    uint8_t pages;		/**< stores pages of display (calculated on initialization*/
-    uint8_t address; 	/**< i2c address of display*/
     i2c_inst_t *i2c_i; 	/**< i2c connection instance */
+    uint8_t address; 	/**< i2c address of display*/
+    uint16_t dma_words[SSD1306_TXSIZE];	/**< front buffer: the frame as i2c DATA_CMD words (DMA mode only) */
+    int dma_chan;		/**< DMA channel feeding the i2c tx fifo, -1 if DMA is not used */
+    alarm_id_t alarm;	/**< deadline of the DMA transfer in flight, 0 if none */
+    int sda;			/**< SDA pin for bus recovery, -1 if unknown */
+    int scl;			/**< SCL pin for bus recovery, -1 if unknown */
+    uint baudrate;		/**< bus speed restored by the recovery */
+    volatile bool recover;	/**< recover the bus before the next transfer */
+    ssd1306_i2c_errors_t errors;	/**< error counters */
+    struct ssd1306 *display;	/**< display fed by this transport */
+} ssd1306_i2c_t;
+
+/**
+*	@brief i2c transport, blocking writes and DMA after ssd1306_dma_init
+*/
+extern const ssd1306_transport_t ssd1306_i2c_transport;
+#endif
+
+/**
+*	@brief holds the configuration
+*/
+typedef struct ssd1306 {
     bool external_vcc; 	/**< whether display uses external vcc */ 
-    uint8_t *buffer;	/**< display buffer */
-    size_t bufsize;		/**< buffer size */
+    uint8_t buffer[SSD1306_BUFSIZE];	/**< display buffer, SSD1306_WIDTH bytes per page */
+    uint8_t shadow[SSD1306_BUFSIZE];	/**< copy of the frame last sent to the display */
+    uint8_t txbuf[SSD1306_TXSIZE];		/**< packed transactions of the frame being sent */
+    uint16_t xfer_end[2*SSD1306_PAGES];	/**< end offset in txbuf of each transaction */
+    uint16_t xfers;		/**< number of transactions in txbuf */
+    bool full_refresh;	/**< next ssd1306_show sends the whole buffer */
+    uint8_t damage[2*SSD1306_PAGES];	/**< first and last damaged column of each page, see ssd1306_add_damage */
+    bool damage_only;	/**< next ssd1306_show compares only the damaged columns */
+    bool scrolling;		/**< continuous hardware scroll running */
+    ssd1306_stats_t stats;	/**< transfer statistics */
+    const ssd1306_transport_t *transport;	/**< moves bytes to the display */
+    void *transport_ctx;	/**< argument passed to the transport */
+    volatile bool busy;	/**< asynchronous transfer in flight */
+    uint32_t xfer_start_us;	/**< start time of the transfer in flight */
+    ssd1306_done_cb_t done_cb;	/**< called when an asynchronous transfer finished */
+    void *done_ctx;		/**< argument passed to done_cb */
+    ssd1306_wait_cb_t wait_cb;	/**< sleeps while busy instead of spinning (NULL: spin) */
+    void *wait_ctx;		/**< argument passed to wait_cb */
+#ifndef SSD1306_HOST
+    ssd1306_i2c_t i2c;	/**< context of the i2c transport used by ssd1306_init */
+#endif
 } ssd1306_t;
 
 /**
 *	@brief initialize display
 *
+*	the geometry comes from SSD1306_PANEL, see ssd1306_panel.h. on panels shorter
+*	than the 64 RAM rows the rows below the panel are cleared
+*
+*	@param[in] p : pointer to instance of ssd1306_t
+*	@param[in] transport : transport moving bytes to the display
+*	@param[in] ctx : argument passed to the transport
+*	
+* 	@return bool.
+*	@retval true for Success
+*	@retval false if initialization failed
+*/
+bool ssd1306_init_with_transport(ssd1306_t *p, const ssd1306_transport_t *transport, void *ctx);
+
+#ifndef SSD1306_HOST
+/**
+*	@brief initialize display connected to i2c
+*
 *	@param[in] p : pointer to instance of ssd1306_t
-*	@param[in] width : width of display
-*	@param[in] height : heigth of display
 *	@param[in] address : i2c address of display
 *	@param[in] i2c_instance : instance of i2c connection
 *	
@@ -83,7 +291,8 @@ typedef struct {
 *	@retval true for Success
 *	@retval false if initialization failed
 */
-bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance);
+bool ssd1306_init(ssd1306_t *p, uint8_t address, i2c_inst_t *i2c_instance);
+#endif
 
 /**
 *	@brief deinitialize display
@@ -93,6 +302,16 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 */
 void ssd1306_deinit(ssd1306_t *p);
 
+/**
+*	@brief send commands in a single transaction
+*
+*	@param[in] p : instance of display
+*	@param[in] cmds : command bytes, including their arguments
+*	@param[in] len : number of bytes in cmds
+*
+*/
+void ssd1306_write_cmds(ssd1306_t *p, const uint8_t *cmds, size_t len);
+
 /**
 *	@brief turn off display
 *
@@ -130,11 +349,220 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	only the regions that differ from the last transmitted frame are sent,
+	each as a column/page address window
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief set callback for finished asynchronous transfers
+
+	@param[in] p : instance of display
+	@param[in] done : called from interrupt context when a transfer finished (may be NULL)
+	@param[in] ctx : argument passed to done
+
+*/
+void ssd1306_set_done_callback(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx);
+
+/**
+	@brief set how blocking calls wait for an asynchronous transfer in flight
+
+	commands, ssd1306_show and ssd1306_deinit have to wait for the frame
+	being sent. by default they spin on the busy flag; with an RTOS, wait
+	should block the calling task until the done callback signals it (a
+	timeout is fine, wait is called again while the transfer is running)
+
+	@param[in] p : instance of display
+	@param[in] wait : called in a loop while a transfer is in flight (may be NULL)
+	@param[in] ctx : argument passed to wait
+
+*/
+void ssd1306_set_wait_callback(ssd1306_t *p, ssd1306_wait_cb_t wait, void *ctx);
+
+/**
+	@brief called by transports when an asynchronous transfer finished, safe in interrupt context
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_transfer_done(ssd1306_t *p);
+
+#ifndef SSD1306_HOST
+/**
+	@brief enable double buffered DMA transfers on the i2c transport
+
+	frames are copied to a front buffer that is streamed to the display by DMA,
+	so the display buffer can be redrawn while the transfer is running
+
+	@param[in] p : instance of display
+	@param[in] done : called from interrupt context when a transfer finished (may be NULL)
+	@param[in] ctx : argument passed to done
+
+	@return bool.
+	@retval true for Success
+	@retval false if no DMA channel is available
+*/
+bool ssd1306_dma_init(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx);
+
+/**
+	@brief let the i2c transport recover a stuck bus
+
+	after a failed or overdue transfer the transport clocks SCL until the
+	display releases SDA, issues a stop and re-initializes the i2c block
+	before the next transfer. Without this only the counters are updated.
+	Call after ssd1306_init, which clears the setting.
+
+	@param[in] p : instance of display
+	@param[in] sda : SDA pin
+	@param[in] scl : SCL pin
+	@param[in] baudrate : bus speed passed to i2c_init
+*/
+void ssd1306_i2c_set_recovery(ssd1306_t *p, uint sda, uint scl, uint baudrate);
+
+/**
+	@brief read the bus error counters of the i2c transport
+
+	the transport never prints; poll this from a low priority task to report errors
+
+	@param[in] p : instance of display
+	@param[out] errors : copy of the counters
+*/
+void ssd1306_i2c_get_errors(ssd1306_t *p, ssd1306_i2c_errors_t *errors);
+#endif
+
+/**
+	@brief start sending the display buffer without waiting for the transfer
+
+	falls back to a blocking transfer if the transport cannot send asynchronously
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true if the frame was queued
+	@retval false if the previous transfer is still in flight
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief check for an asynchronous transfer in flight
+
+	@param[in] p : instance of display
+
+	@return true while the front buffer is being sent
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
+/**
+	@brief force the next ssd1306_show to send the whole buffer
+
+	use after the display RAM was changed behind the driver's back
+	(e.g. after a power cycle of the panel)
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
+/**
+	@brief report a rectangle of the buffer that changed since the last ssd1306_show
+
+	once called, the next ssd1306_show compares only the damaged columns of each page
+	against the last frame sent, so every change of that frame must be reported.
+	without any report the whole buffer is compared.
+
+	@param[in] p : instance of display
+	@param[in] x : x position of the rectangle, may be negative
+	@param[in] y : y position of the rectangle, may be negative
+	@param[in] width : width of the rectangle
+	@param[in] height : height of the rectangle
+*/
+void ssd1306_add_damage(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height);
+
+/**
+	@brief start continuous horizontal scroll of a range of pages
+
+	the controller moves the display RAM itself, so nothing is transferred while it runs.
+	the buffer must not be shown until ssd1306_scroll_stop, the scrolled pages would be garbled.
+
+	@param[in] p : instance of display
+	@param[in] dir : direction
+	@param[in] page_start : first page scrolled
+	@param[in] page_end : last page scrolled
+	@param[in] speed : time between two steps
+
+	@return bool.
+	@retval true if the scroll is running
+	@retval false if the controller has no hardware scroll (sh1106) or the pages are out of range
+*/
+bool ssd1306_scroll_start(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page_start, uint8_t page_end, ssd1306_scroll_speed_t speed);
+
+/**
+	@brief start continuous diagonal scroll: the pages move horizontally and the whole display vertically
+
+	same restrictions as ssd1306_scroll_start
+
+	@param[in] p : instance of display
+	@param[in] dir : horizontal direction
+	@param[in] page_start : first page scrolled horizontally
+	@param[in] page_end : last page scrolled horizontally
+	@param[in] speed : time between two steps
+	@param[in] vertical_step : rows moved up per step, 0 to SSD1306_HEIGHT-1
+
+	@return bool.
+	@retval true if the scroll is running
+	@retval false if the controller has no hardware scroll (sh1106) or the arguments are out of range
+*/
+bool ssd1306_scroll_start_diagonal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page_start, uint8_t page_end, ssd1306_scroll_speed_t speed, uint8_t vertical_step);
+
+/**
+	@brief stop the continuous scroll
+
+	the scroll left the display RAM moved, so the next ssd1306_show sends the whole buffer
+
+	@param[in] p : instance of display
+*/
+void ssd1306_scroll_stop(ssd1306_t *p);
+
+/**
+	@brief set the RAM row shown on the top line of the display
+
+	rolls the image vertically without touching the display RAM. the rows
+	wrap at the end of the 64 row RAM, not of the panel: on a shorter panel
+	the cleared rows below it come into view
+
+	@param[in] p : instance of display
+	@param[in] line : RAM row, 0 to 63
+*/
+void ssd1306_set_start_line(ssd1306_t *p, uint8_t line);
+
+/**
+	@brief shift the COM lines of the display vertically
+
+	@param[in] p : instance of display
+	@param[in] offset : vertical shift in rows, 0 to 63
+*/
+void ssd1306_set_display_offset(ssd1306_t *p, uint8_t offset);
+
+/**
+	@brief get transfer statistics
+
+	@param[in] p : instance of display
+	@param[out] stats : copy of the statistics
+
+*/
+void ssd1306_get_stats(ssd1306_t *p, ssd1306_stats_t *stats);
+
+/**
+	@brief reset transfer statistics
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_reset_stats(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -172,6 +600,64 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 */
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 
+/**
+	@brief apply raster operation to pixel on buffer
+
+	@param[in] p : instance of display
+	@param[in] x : x position
+	@param[in] y : y position
+	@param[in] rop : raster operation
+*/
+void ssd1306_draw_pixel_rop(ssd1306_t *p, int32_t x, int32_t y, ssd1306_rop_t rop);
+
+/**
+	@brief draw line on buffer with raster operation (integer Bresenham)
+
+	@param[in] p : instance of display
+	@param[in] x1 : x position of starting point
+	@param[in] y1 : y position of starting point
+	@param[in] x2 : x position of end point
+	@param[in] y2 : y position of end point
+	@param[in] rop : raster operation
+*/
+void ssd1306_draw_line_rop(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2, ssd1306_rop_t rop);
+
+/**
+	@brief draw horizontal line on buffer
+
+	@param[in] p : instance of display
+	@param[in] x : x position of starting point
+	@param[in] y : y position of line
+	@param[in] width : length of line
+	@param[in] rop : raster operation
+*/
+void ssd1306_draw_hline(ssd1306_t *p, int32_t x, int32_t y, int32_t width, ssd1306_rop_t rop);
+
+/**
+	@brief draw vertical line on buffer
+
+	@param[in] p : instance of display
+	@param[in] x : x position of line
+	@param[in] y : y position of starting point
+	@param[in] height : length of line
+	@param[in] rop : raster operation
+*/
+void ssd1306_draw_vline(ssd1306_t *p, int32_t x, int32_t y, int32_t height, ssd1306_rop_t rop);
+
+/**
+	@brief fill rectangle on buffer with raster operation, clipped to the display
+
+	works a page at a time with one mask per page
+
+	@param[in] p : instance of display
+	@param[in] x : x position of starting point
+	@param[in] y : y position of starting point
+	@param[in] width : width of rectangle
+	@param[in] height : height of rectangle
+	@param[in] rop : raster operation
+*/
+void ssd1306_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height, ssd1306_rop_t rop);
+
 /**
 	@brief clear square at given position with given size
 
@@ -194,6 +680,17 @@ void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width,
 */
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 
+/**
+	@brief invert square at given position with given size
+
+	@param[in] p : instance of display
+	@param[in] x : x position of starting point
+	@param[in] y : y position of starting point
+	@param[in] width : width of square
+	@param[in] height : height of square
+*/
+void ssd1306_invert_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
 /**
 	@brief draw empty square at given position with given size
 
@@ -225,6 +722,77 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
 */
 void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
 
+/**
+	@brief build the shifted copies of a sprite
+
+	@param[out] s : sprite to initialize
+	@param[in] storage : SSD1306_SPRITE_STORAGE_SIZE(width, height) bytes, must outlive the sprite
+	@param[in] cols : image as columns of vertical bytes, LSB on top, (height+7)/8 bytes per column
+	@param[in] width : width of image
+	@param[in] height : height of image
+*/
+void ssd1306_sprite_init(ssd1306_sprite_t *s, uint8_t *storage, const uint8_t *cols, uint8_t width, uint8_t height);
+
+/**
+	@brief draw sprite, clipped to the display
+
+	@param[in] p : instance of display
+	@param[in] s : sprite
+	@param[in] x : x position of upper left corner, may be negative
+	@param[in] y : y position of upper left corner, may be negative
+	@param[in] mode : transparent or opaque
+*/
+void ssd1306_draw_sprite(ssd1306_t *p, const ssd1306_sprite_t *s, int32_t x, int32_t y, ssd1306_sprite_mode_t mode);
+
+/**
+	@brief draw page-format image, clipped to the display
+
+	page-aligned opaque images are copied with memcpy, other positions are shifted while drawing
+
+	@param[in] p : instance of display
+	@param[in] img : image
+	@param[in] x : x position of upper left corner, may be negative
+	@param[in] y : y position of upper left corner, may be negative
+	@param[in] mode : transparent or opaque
+*/
+void ssd1306_draw_image(ssd1306_t *p, const ssd1306_image_t *img, int32_t x, int32_t y, ssd1306_sprite_mode_t mode);
+
+/**
+	@brief draw glyph of a compiled font
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of glyph
+	@param[in] y : y starting position of glyph
+	@param[in] font : compiled font
+	@param[in] c : character to draw
+
+	@return advance in pixels (glyph width plus spacing), 0 if the font has no such character
+*/
+uint32_t ssd1306_draw_glyph(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_font_t *font, char c);
+
+/**
+	@brief draw string with a compiled font, proportionally spaced
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of text
+	@param[in] y : y starting position of text
+	@param[in] font : compiled font
+	@param[in] s : text to draw
+
+	@return x position after the last glyph
+*/
+uint32_t ssd1306_draw_text(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_font_t *font, const char *s);
+
+/**
+	@brief width of a string in a compiled font, without the spacing after the last glyph
+
+	@param[in] font : compiled font
+	@param[in] s : text to measure
+
+	@return width in pixels
+*/
+uint32_t ssd1306_text_width(const ssd1306_font_t *font, const char *s);
+
 /**
 	@brief draw char with given font
 
@@ -0,0 +1,102 @@
+/*
+
+MIT License
+
+Copyright (c) 2021 David Schramm
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/** 
+* @file ssd1306_mem.h
+* 
+* in-memory ssd1306 for host builds: interprets the command/data stream
+* like the controller and keeps a copy of its display RAM
+*/
+
+#ifndef _inc_ssd1306_mem
+#define _inc_ssd1306_mem
+#include "ssd1306.h"
+
+#define SSD1306_MEM_COLUMNS SSD1306_RAM_COLUMNS	/**< columns of the controller RAM */
+#define SSD1306_MEM_PAGES SSD1306_RAM_PAGES	/**< pages of the controller RAM */
+
+/**
+*	@brief emulated controller state
+*/
+typedef struct {
+    uint8_t ram[SSD1306_MEM_PAGES][SSD1306_MEM_COLUMNS];	/**< display RAM */
+    uint8_t mem_mode;		/**< addressing mode set by SET_MEM_ADDR */
+    uint8_t col_start;		/**< column window */
+    uint8_t col_end;
+    uint8_t page_start;		/**< page window */
+    uint8_t page_end;
+    uint8_t col;			/**< RAM pointer */
+    uint8_t page;
+    uint8_t cmd[8];			/**< command being received */
+    uint8_t cmd_len;		/**< bytes of cmd received */
+    uint8_t cmd_need;		/**< bytes of cmd expected */
+    bool display_on;		/**< SET_DISP state */
+    bool inverted;			/**< SET_NORM_INV state */
+    uint8_t contrast;		/**< SET_CONTRAST value */
+    uint8_t start_line;		/**< SET_DISP_START_LINE value */
+    uint8_t display_offset;	/**< SET_DISP_OFFSET value */
+    bool scrolling;			/**< continuous scroll active (the RAM is not moved) */
+    uint32_t transactions;	/**< transactions received */
+    uint32_t bytes;			/**< bytes received, control bytes included */
+} ssd1306_mem_t;
+
+/**
+*	@brief transport writing into a ssd1306_mem_t
+*/
+extern const ssd1306_transport_t ssd1306_mem_transport;
+
+/**
+*	@brief reset emulated controller
+
+	the visible area is the one of SSD1306_PANEL
+
+	@param[out] m : emulated controller
+*/
+void ssd1306_mem_init(ssd1306_mem_t *m);
+
+/**
+	@brief read visible pixel from the emulated display RAM
+
+	the row follows the start line, wrapping at the end of the RAM
+
+	@param[in] m : emulated controller
+	@param[in] x : x position
+	@param[in] y : y position
+
+	@return true if the pixel is lit
+*/
+bool ssd1306_mem_get_pixel(const ssd1306_mem_t *m, uint32_t x, uint32_t y);
+
+/**
+	@brief save visible area as binary PBM, lit pixels white
+
+	@param[in] m : emulated controller
+	@param[in] path : output file
+
+	@return false if the file could not be written
+*/
+bool ssd1306_mem_write_pbm(const ssd1306_mem_t *m, const char *path);
+
+#endif
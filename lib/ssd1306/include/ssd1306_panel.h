@@ -0,0 +1,57 @@
+/**
+* @file ssd1306_panel.h
+*
+* geometry of the panel, chosen at build time
+*
+* define SSD1306_PANEL as one of the SSD1306_PANEL_* values (default 128x64).
+* width, height and RAM layout become constants, so the buffers are sized
+* statically and the pixel math reduces to shifts and constants.
+*/
+
+#ifndef _inc_ssd1306_panel
+#define _inc_ssd1306_panel
+
+#define SSD1306_PANEL_128X64 1			/**< ssd1306, 128x64 */
+#define SSD1306_PANEL_128X32 2			/**< ssd1306, 128x32 */
+#define SSD1306_PANEL_64X48 3			/**< ssd1306, 64x48, visible from column 32 */
+#define SSD1306_PANEL_SH1106_128X64 4	/**< sh1106, 132 column RAM, visible from column 2 */
+
+#ifndef SSD1306_PANEL
+#define SSD1306_PANEL SSD1306_PANEL_128X64
+#endif
+
+#if SSD1306_PANEL==SSD1306_PANEL_128X64
+#define SSD1306_WIDTH 128
+#define SSD1306_HEIGHT 64
+#define SSD1306_COL_OFFSET 0
+#define SSD1306_COM_PINS 0x12
+#elif SSD1306_PANEL==SSD1306_PANEL_128X32
+#define SSD1306_WIDTH 128
+#define SSD1306_HEIGHT 32
+#define SSD1306_COL_OFFSET 0
+#define SSD1306_COM_PINS 0x02
+#elif SSD1306_PANEL==SSD1306_PANEL_64X48
+#define SSD1306_WIDTH 64
+#define SSD1306_HEIGHT 48
+#define SSD1306_COL_OFFSET 32
+#define SSD1306_COM_PINS 0x12
+#elif SSD1306_PANEL==SSD1306_PANEL_SH1106_128X64
+#define SSD1306_WIDTH 128
+#define SSD1306_HEIGHT 64
+#define SSD1306_COL_OFFSET 2
+#define SSD1306_COM_PINS 0x12
+#define SSD1306_SH1106 1
+#else
+#error "unknown SSD1306_PANEL"
+#endif
+
+#ifndef SSD1306_SH1106
+#define SSD1306_SH1106 0	/**< sh1106 controller: page addressing only, 132 column RAM */
+#endif
+
+#define SSD1306_PAGES (SSD1306_HEIGHT/8)				/**< pages of the panel */
+#define SSD1306_BUFSIZE (SSD1306_WIDTH*SSD1306_PAGES)	/**< bytes of a frame */
+#define SSD1306_RAM_COLUMNS (SSD1306_SH1106?132:128)	/**< columns of the controller RAM */
+#define SSD1306_RAM_PAGES 8								/**< pages of the controller RAM, 64 rows on every panel */
+
+#endif
@@ -0,0 +1,106 @@
+/*
+
+MIT License
+
+Copyright (c) 2021 David Schramm
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file ssd1306_pio.h
+*
+* transport on a PIO state machine fed by DMA: i2c beyond the speed of
+* the i2c block, or 4-wire spi for spi modules
+*/
+
+#ifndef _inc_ssd1306_pio
+#define _inc_ssd1306_pio
+#include <hardware/pio.h>
+#include "ssd1306.h"
+
+#define SSD1306_PIO_WORDS (SSD1306_TXSIZE+2*SSD1306_PAGES)	/**< fifo words of the largest frame, i2c address bytes included */
+
+/**
+*	@brief bus driven by the state machine
+*/
+typedef enum {
+    SSD1306_PIO_I2C,	/**< SDA/SCL, write only (acks are not checked) */
+    SSD1306_PIO_SPI		/**< MOSI/SCK plus D/C, chip select held low */
+} ssd1306_pio_bus_t;
+
+/**
+*	@brief context of the PIO transport
+*/
+typedef struct {
+    PIO pio;			/**< PIO instance */
+    uint sm;			/**< state machine */
+    uint offset;		/**< program offset in the instruction memory */
+    int dma_chan;		/**< DMA channel feeding the tx fifo */
+    ssd1306_pio_bus_t bus;	/**< bus driven by the program */
+    uint8_t address;	/**< i2c address of display */
+    uint32_t words[SSD1306_PIO_WORDS];	/**< front buffer: the frame as fifo words */
+    struct ssd1306 *display;	/**< display fed by this transport */
+} ssd1306_pio_t;
+
+/**
+*	@brief PIO transport, DMA for ssd1306_show_async, fifo writes for commands
+*/
+extern const ssd1306_transport_t ssd1306_pio_transport;
+
+/**
+*	@brief initialize display connected to i2c through a PIO state machine
+
+	the SSD1306 datasheet specifies 400 kHz, most modules accept well above
+	that; measure the rate with the render_bench before relying on it
+
+	@param[in] p : pointer to instance of ssd1306_t
+	@param[in] t : transport context, must outlive the display
+	@param[in] pio : PIO instance with a free state machine
+	@param[in] sda : SDA pin
+	@param[in] scl : SCL pin
+	@param[in] address : i2c address of display
+	@param[in] baudrate : SCL frequency in Hz
+
+	@return bool.
+	@retval true for Success
+	@retval false if no state machine, program space or DMA channel is available
+*/
+bool ssd1306_init_pio_i2c(ssd1306_t *p, ssd1306_pio_t *t, PIO pio, uint sda, uint scl, uint8_t address, uint32_t baudrate);
+
+/**
+*	@brief initialize display connected to 4-wire spi through a PIO state machine
+
+	@param[in] p : pointer to instance of ssd1306_t
+	@param[in] t : transport context, must outlive the display
+	@param[in] pio : PIO instance with a free state machine
+	@param[in] mosi : MOSI (D1) pin
+	@param[in] sck : SCK (D0) pin
+	@param[in] dc : data/command pin
+	@param[in] cs : chip select pin, held low
+	@param[in] rst : reset pin, pulsed before the init sequence, -1 if not connected
+	@param[in] baudrate : SCK frequency in Hz (10 MHz max per datasheet)
+
+	@return bool.
+	@retval true for Success
+	@retval false if no state machine, program space or DMA channel is available
+*/
+bool ssd1306_init_pio_spi(ssd1306_t *p, ssd1306_pio_t *t, PIO pio, uint mosi, uint sck, uint dc, uint cs, int rst, uint32_t baudrate);
+
+#endif
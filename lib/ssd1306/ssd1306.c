@@ -23,57 +23,114 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#ifndef SSD1306_HOST
 #include <pico/stdlib.h>
-#include <hardware/i2c.h>
-#include <pico/binary_info.h>
-#include <stdlib.h>
+#else
+#include <time.h>
+#endif
 #include <string.h>
 #include <stdio.h>
 
 #include "ssd1306.h"
 #include "font.h"
 
+/* approximate cost in bytes of opening an address window (command transactions + control byte) */
+#define SSD1306_WINDOW_COST 12
+/* commands of an address window, sent as one transaction */
+#define SSD1306_WINDOW_CMDS 6
+/* bytes of an address window besides its data: two control bytes and the commands */
+#define SSD1306_WINDOW_OVERHEAD (SSD1306_WINDOW_CMDS+2)
+_Static_assert(SSD1306_WINDOW_OVERHEAD<=(SSD1306_TXSIZE-SSD1306_BUFSIZE)/SSD1306_PAGES, "txbuf too small");
+/* sh1106: DC-DC converter control, followed by one argument */
+#define SH1106_SET_DCDC 0xAD
+/* sh1106: page address, column low and high nibble in page addressing mode */
+#define SH1106_SET_PAGE 0xB0
+#define SH1106_SET_COL_LO 0x00
+#define SH1106_SET_COL_HI 0x10
+/* commands sent per transaction by ssd1306_write_cmds */
+#define SSD1306_MAX_CMDS 32
+
+/* tallest scaled glyph rendered, in pixels (clipped to the display height anyway) */
+#define SSD1306_MAX_SCALED_HEIGHT 256
+
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
+    int32_t t=*a;
     *a=*b;
-    *b=*t;
+    *b=t;
 }
 
-inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
-    switch(i2c_write_blocking(i2c, addr, src, len, false)) {
-    case PICO_ERROR_GENERIC:
-        printf("[%s] addr not acknowledged!\n", name);
-        break;
-    case PICO_ERROR_TIMEOUT:
-        printf("[%s] timeout!\n", name);
-        break;
-    default:
-        //printf("[%s] wrote successfully %lu bytes!\n", name, len);
-        break;
-    }
+#ifdef SSD1306_HOST
+static uint32_t time_us_32(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec*1000000u+ts.tv_nsec/1000;
 }
+#endif
+
+static void ssd1306_wait_idle(ssd1306_t *p) {
+    while(p->busy)
+        if(p->wait_cb)
+            p->wait_cb(p->wait_ctx);
 
-inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
-    uint8_t d[2]= {0x00, val};
-    fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
+    if(p->transport->wait_idle)
+        p->transport->wait_idle(p->transport_ctx);
 }
 
-bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
-    p->width=width;
-    p->height=height;
-    p->pages=height/8;
-    p->address=address;
+void ssd1306_write_cmds(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    // a single 0x00 control byte (Co=0) makes the display read every following byte as a command
+    uint8_t d[1+SSD1306_MAX_CMDS];
+    d[0]=0x00;
 
-    p->i2c_i=i2c_instance;
+    ssd1306_wait_idle(p);
 
+    while(len) {
+        const size_t n=len<SSD1306_MAX_CMDS?len:SSD1306_MAX_CMDS;
+        memcpy(d+1, cmds, n);
+        p->transport->write(p->transport_ctx, d, n+1);
+        cmds+=n;
+        len-=n;
+    }
+}
 
-    p->bufsize=(p->pages)*(p->width);
-    if((p->buffer=malloc(p->bufsize+1))==NULL) {
-        p->bufsize=0;
-        return false;
+#if !SSD1306_SH1106
+/* zero the RAM pages below the panel: ssd1306_show never sends them, but a start line that wraps shows them */
+static void ssd1306_clear_hidden_pages(ssd1306_t *p) {
+    const uint8_t cmds[]= {SET_COL_ADDR, 0, SSD1306_RAM_COLUMNS-1, SET_PAGE_ADDR, SSD1306_PAGES, SSD1306_RAM_PAGES-1};
+    uint8_t d[1+SSD1306_RAM_COLUMNS];
+
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+
+    d[0]=0x40;
+    memset(d+1, 0, SSD1306_RAM_COLUMNS);
+    for(uint8_t page=SSD1306_PAGES; page<SSD1306_RAM_PAGES; ++page)
+        p->transport->write(p->transport_ctx, d, sizeof(d));
+}
+#endif
+
+static void ssd1306_reset_damage(ssd1306_t *p) {
+    // lo > hi marks an undamaged page
+    for(uint8_t page=0; page<SSD1306_PAGES; ++page) {
+        p->damage[2*page]=0xFF;
+        p->damage[2*page+1]=0;
     }
+    p->damage_only=false;
+}
+
+bool ssd1306_init_with_transport(ssd1306_t *p, const ssd1306_transport_t *transport, void *ctx) {
+    p->transport=transport;
+    p->transport_ctx=ctx;
 
-    ++(p->buffer);
+    ssd1306_reset_damage(p);
+    p->xfers=0;
+    p->full_refresh=true;
+    memset(&p->stats, 0, sizeof(p->stats));
+
+    p->busy=false;
+    p->scrolling=false;
+    p->done_cb=NULL;
+    p->done_ctx=NULL;
+    p->wait_cb=NULL;
+    p->wait_ctx=NULL;
 
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
@@ -82,18 +139,24 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         SET_DISP_CLK_DIV,
         0x80,
         SET_MUX_RATIO,
-        height - 1,
+        SSD1306_HEIGHT - 1,
         SET_DISP_OFFSET,
         0x00,
         // resolution and layout
         SET_DISP_START_LINE,
+#if SSD1306_SH1106
+        // DC-DC converter
+        SH1106_SET_DCDC,
+        p->external_vcc?0x8A:0x8B,
+#else
         // charge pump
         SET_CHARGE_PUMP,
         p->external_vcc?0x10:0x14,
+#endif
         SET_SEG_REMAP | 0x01,           // column addr 127 mapped to SEG0
         SET_COM_OUT_DIR | 0x08,         // scan from COM[N] to COM0
         SET_COM_PIN_CFG,
-        width>2*height?0x02:0x12,
+        SSD1306_COM_PINS,
         // display
         SET_CONTRAST,
         0xff,
@@ -104,121 +167,378 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         SET_ENTIRE_ON,                  // output follows RAM contents
         SET_NORM_INV,                   // not inverted
         SET_DISP | 0x01,
+#if !SSD1306_SH1106
         // address setting
         SET_MEM_ADDR,
         0x00,  // horizontal
+#endif
     };
 
-    for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+#if !SSD1306_SH1106
+    if(SSD1306_PAGES<SSD1306_RAM_PAGES)
+        ssd1306_clear_hidden_pages(p);
+#endif
 
     return true;
 }
 
-inline void ssd1306_deinit(ssd1306_t *p) {
-    free(p->buffer-1);
+void ssd1306_deinit(ssd1306_t *p) {
+    ssd1306_wait_idle(p);
+
+    if(p->transport->deinit)
+        p->transport->deinit(p->transport_ctx);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x00);
+    const uint8_t cmds[]= {SET_DISP|0x00};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_poweron(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x01);
+    const uint8_t cmds[]= {SET_DISP|0x01};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+    const uint8_t cmds[]= {SET_CONTRAST, val};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
-    ssd1306_write(p, SET_NORM_INV | (inv & 1));
+    const uint8_t cmds[]= {SET_NORM_INV | (inv & 1)};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_clear(ssd1306_t *p) {
-    memset(p->buffer, 0, p->bufsize);
+    memset(p->buffer, 0, SSD1306_BUFSIZE);
 }
 
 void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
-    if(x>=p->width || y>=p->height) return;
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
 
-    p->buffer[x+p->width*(y>>3)]&=~(0x1<<(y&0x07));
+    p->buffer[x+SSD1306_WIDTH*(y>>3)]&=~(0x1<<(y&0x07));
 }
 
 void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
-    if(x>=p->width || y>=p->height) return;
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
 
-    p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
+    p->buffer[x+SSD1306_WIDTH*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
 }
 
-void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    if(x1>x2) {
-        swap(&x1, &x2);
-        swap(&y1, &y2);
+inline void ssd1306_draw_pixel_rop(ssd1306_t *p, int32_t x, int32_t y, ssd1306_rop_t rop) {
+    if(x<0 || y<0 || x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
+
+    uint8_t *dst=p->buffer+x+SSD1306_WIDTH*(y>>3);
+    const uint8_t mask=0x1<<(y&0x07);
+
+    switch(rop) {
+    case SSD1306_ROP_OR:
+        *dst|=mask;
+        break;
+    case SSD1306_ROP_AND:
+        *dst&=~mask;
+        break;
+    case SSD1306_ROP_XOR:
+        *dst^=mask;
+        break;
+    }
+}
+
+/* apply mask to len consecutive bytes of one page */
+static inline void ssd1306_rop_span(uint8_t *dst, uint32_t len, uint8_t mask, ssd1306_rop_t rop) {
+    switch(rop) {
+    case SSD1306_ROP_OR:
+        if(mask==0xFF)
+            memset(dst, 0xFF, len);
+        else
+            for(uint32_t i=0; i<len; ++i)
+                dst[i]|=mask;
+        break;
+    case SSD1306_ROP_AND:
+        if(mask==0xFF)
+            memset(dst, 0x00, len);
+        else
+            for(uint32_t i=0; i<len; ++i)
+                dst[i]&=~mask;
+        break;
+    case SSD1306_ROP_XOR:
+        for(uint32_t i=0; i<len; ++i)
+            dst[i]^=mask;
+        break;
+    }
+}
+
+void ssd1306_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height, ssd1306_rop_t rop) {
+    int32_t x0=x<0?0:x, y0=y<0?0:y;
+    int32_t x1=x+width, y1=y+height;
+    if(x1>SSD1306_WIDTH) x1=SSD1306_WIDTH;
+    if(y1>SSD1306_HEIGHT) y1=SSD1306_HEIGHT;
+    if(x0>=x1 || y0>=y1) return;
+
+    const int32_t page_first=y0>>3;
+    const int32_t page_last=(y1-1)>>3;
+
+    for(int32_t page=page_first; page<=page_last; ++page) {
+        uint8_t mask=0xFF;
+        if(page==page_first)
+            mask&=0xFF<<(y0&7);
+        if(page==page_last)
+            mask&=0xFF>>(7-((y1-1)&7));
+
+        ssd1306_rop_span(p->buffer+page*SSD1306_WIDTH+x0, x1-x0, mask, rop);
+    }
+}
+
+inline void ssd1306_draw_hline(ssd1306_t *p, int32_t x, int32_t y, int32_t width, ssd1306_rop_t rop) {
+    ssd1306_fill_rect(p, x, y, width, 1, rop);
+}
+
+inline void ssd1306_draw_vline(ssd1306_t *p, int32_t x, int32_t y, int32_t height, ssd1306_rop_t rop) {
+    ssd1306_fill_rect(p, x, y, 1, height, rop);
+}
+
+void ssd1306_draw_line_rop(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2, ssd1306_rop_t rop) {
+    if(y1==y2) {
+        if(x1>x2)
+            swap(&x1, &x2);
+        ssd1306_draw_hline(p, x1, y1, x2-x1+1, rop);
+        return;
     }
 
     if(x1==x2) {
         if(y1>y2)
             swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+        ssd1306_draw_vline(p, x1, y1, y2-y1+1, rop);
         return;
     }
 
-    float m=(float) (y2-y1) / (float) (x2-x1);
+    // Bresenham, every pixel is visited once so XOR lines stay intact
+    const int32_t dx=x2>x1?x2-x1:x1-x2;
+    const int32_t dy=y2>y1?y1-y2:y2-y1;
+    const int32_t sx=x1<x2?1:-1;
+    const int32_t sy=y1<y2?1:-1;
+    int32_t err=dx+dy;
 
-    for(int32_t i=x1; i<=x2; ++i) {
-        float y=m*(float) (i-x1)+(float) y1;
-        ssd1306_draw_pixel(p, i, (uint32_t) y);
+    for(;;) {
+        ssd1306_draw_pixel_rop(p, x1, y1, rop);
+        if(x1==x2 && y1==y2)
+            break;
+
+        const int32_t e2=2*err;
+        if(e2>=dy) {
+            err+=dy;
+            x1+=sx;
+        }
+        if(e2<=dx) {
+            err+=dx;
+            y1+=sy;
+        }
     }
 }
 
+inline void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    ssd1306_draw_line_rop(p, x1, y1, x2, y2, SSD1306_ROP_OR);
+}
+
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
+    ssd1306_fill_rect(p, x, y, width<SSD1306_WIDTH?width:SSD1306_WIDTH, height<SSD1306_HEIGHT?height:SSD1306_HEIGHT, SSD1306_ROP_AND);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
+    ssd1306_fill_rect(p, x, y, width<SSD1306_WIDTH?width:SSD1306_WIDTH, height<SSD1306_HEIGHT?height:SSD1306_HEIGHT, SSD1306_ROP_OR);
+}
+
+void ssd1306_invert_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
+    ssd1306_fill_rect(p, x, y, width<SSD1306_WIDTH?width:SSD1306_WIDTH, height<SSD1306_HEIGHT?height:SSD1306_HEIGHT, SSD1306_ROP_XOR);
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    ssd1306_draw_line(p, x, y, x+width, y);
-    ssd1306_draw_line(p, x, y+height, x+width, y+height);
-    ssd1306_draw_line(p, x, y, x, y+height);
-    ssd1306_draw_line(p, x+width, y, x+width, y+height);
+    ssd1306_draw_hline(p, x, y, width+1, SSD1306_ROP_OR);
+    ssd1306_draw_hline(p, x, y+height, width+1, SSD1306_ROP_OR);
+    ssd1306_draw_vline(p, x, y, height+1, SSD1306_ROP_OR);
+    ssd1306_draw_vline(p, x+width, y, height+1, SSD1306_ROP_OR);
+}
+
+/*
+ * OR columns of vertical bytes (LSB on top, parts bytes per column) into the buffer.
+ * columns are stride bytes apart, stride 0 repeats the same column.
+ * y not aligned to a page splits every byte over two pages.
+ */
+static void ssd1306_blit_columns(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *cols, uint32_t width, uint32_t parts, uint32_t stride) {
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT)
+        return;
+
+    if(width>SSD1306_WIDTH-x)
+        width=SSD1306_WIDTH-x;
+
+    const uint32_t shift=y&7;
+    const uint32_t page0=y>>3;
+
+    for(uint32_t lp=0; lp<parts && page0+lp<SSD1306_PAGES; ++lp) {
+        uint8_t *row=p->buffer+(page0+lp)*SSD1306_WIDTH+x;
+        const uint8_t *src=cols+lp;
+
+        if(!shift) {
+            for(uint32_t i=0; i<width; ++i, src+=stride)
+                row[i]|=*src;
+        } else if(page0+lp+1<SSD1306_PAGES) {
+            uint8_t *next=row+SSD1306_WIDTH;
+            for(uint32_t i=0; i<width; ++i, src+=stride) {
+                row[i]|=*src<<shift;
+                next[i]|=*src>>(8-shift);
+            }
+        } else {
+            for(uint32_t i=0; i<width; ++i, src+=stride)
+                row[i]|=*src<<shift;
+        }
+    }
+}
+
+/* set len bits starting at bit start of a vertical byte column */
+static inline void ssd1306_set_bits(uint8_t *col, uint32_t start, uint32_t len) {
+    while(len) {
+        const uint32_t off=start&7;
+        const uint32_t n=len<8-off?len:8-off;
+        col[start>>3]|=((1u<<n)-1)<<off;
+        start+=n;
+        len-=n;
+    }
 }
 
 void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
-    uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
-    for(uint8_t w=0; w<font[1]; ++w) { // width
-        uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
-        for(uint32_t lp=0; lp<parts_per_line; ++lp) {
-            uint8_t line=font[pp];
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT || scale==0)
+        return;
 
-            for(int8_t j=0; j<8; ++j, line>>=1) {
-                if(line & 1)
-                    ssd1306_draw_square(p, x+w*scale, y+((lp<<3)+j)*scale, scale, scale);
-            }
+    const uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+    const uint8_t *glyph=font+5+(c-font[3])*font[1]*parts_per_line;
+
+    if(scale==1) {
+        ssd1306_blit_columns(p, x, y, glyph, font[1], parts_per_line, parts_per_line);
+        return;
+    }
+
+    // scaled: stretch each column vertically once, then repeat it scale times
+    uint8_t col[(SSD1306_MAX_SCALED_HEIGHT+7)/8];
+    uint32_t height=font[0]*scale;
+    if(height>SSD1306_HEIGHT-y)
+        height=SSD1306_HEIGHT-y;
+    const uint32_t parts=(height+7)>>3;
+
+    for(uint8_t w=0; w<font[1]; ++w, glyph+=parts_per_line) {
+        const uint32_t cx=x+w*scale;
+        if(cx>=SSD1306_WIDTH)
+            break;
 
-            ++pp;
+        memset(col, 0, parts);
+        for(uint32_t j=0; j<font[0] && j*scale<height; ++j) {
+            if(glyph[j>>3]&(1<<(j&7))) {
+                const uint32_t len=(j+1)*scale<=height?scale:height-j*scale;
+                ssd1306_set_bits(col, j*scale, len);
+            }
         }
+
+        ssd1306_blit_columns(p, cx, y, col, scale, parts, 0);
     }
 }
 
 void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, const char *s) {
-    for(int32_t x_n=x; *s; x_n+=(font[1]+font[2])*scale) {
+    for(uint32_t x_n=x; *s && x_n<SSD1306_WIDTH; x_n+=(font[1]+font[2])*scale) {
         ssd1306_draw_char_with_font(p, x_n, y, scale, font, *(s++));
     }
 }
 
+void ssd1306_sprite_init(ssd1306_sprite_t *s, uint8_t *storage, const uint8_t *cols, uint8_t width, uint8_t height) {
+    const uint32_t parts=(height+7)>>3;
+
+    s->width=width;
+    s->height=height;
+    s->stride=parts+1;
+    s->data=storage;
+
+    for(uint32_t shift=0; shift<8; ++shift) {
+        for(uint32_t page=0; page<s->stride; ++page) {
+            for(uint32_t c=0; c<width; ++c) {
+                const uint8_t cur=page<parts?cols[c*parts+page]:0;
+                const uint8_t prev=page>0?cols[c*parts+page-1]:0;
+                *storage++=(cur<<shift)|(shift?prev>>(8-shift):0);
+            }
+        }
+    }
+}
+
+void ssd1306_draw_sprite(ssd1306_t *p, const ssd1306_sprite_t *s, int32_t x, int32_t y, ssd1306_sprite_mode_t mode) {
+    int32_t x0=x<0?0:x;
+    int32_t x1=x+s->width;
+    if(x1>SSD1306_WIDTH) x1=SSD1306_WIDTH;
+    if(x0>=x1 || y>=SSD1306_HEIGHT || y+s->height<=0) return;
+
+    const uint32_t shift=y&7;
+    const int32_t page0=(y-(int32_t)shift)/8;
+    const uint32_t pages=(s->height+shift+7)>>3;
+    const uint32_t len=x1-x0;
+    const uint8_t *src=s->data+shift*s->stride*s->width+(x0-x);
+
+    for(uint32_t k=0; k<pages; ++k, src+=s->width) {
+        const int32_t page=page0+k;
+        if(page<0)
+            continue;
+        if(page>=SSD1306_PAGES)
+            break;
+
+        uint8_t *row=p->buffer+page*SSD1306_WIDTH+x0;
+
+        if(mode==SSD1306_SPRITE_TRANSPARENT) {
+            for(uint32_t i=0; i<len; ++i)
+                row[i]|=src[i];
+            continue;
+        }
+
+        // opaque: clear the part of the bounding box on this page first
+        uint8_t mask=0xFF;
+        if(k==0)
+            mask&=0xFF<<shift;
+        if(k==pages-1)
+            mask&=0xFF>>(7-((shift+s->height-1)&7));
+
+        for(uint32_t i=0; i<len; ++i)
+            row[i]=(row[i]&~mask)|src[i];
+    }
+}
+
+uint32_t ssd1306_draw_glyph(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_font_t *font, char c) {
+    const uint8_t ch=(uint8_t)c;
+    if(ch<font->first||ch>font->last)
+        return 0;
+
+    const uint32_t i=ch-font->first;
+    ssd1306_blit_columns(p, x, y, font->data+font->offsets[i], font->widths[i], font->pages, font->pages);
+    return font->widths[i]+font->spacing;
+}
+
+uint32_t ssd1306_draw_text(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_font_t *font, const char *s) {
+    for(; *s && x<SSD1306_WIDTH; ++s)
+        x+=ssd1306_draw_glyph(p, x, y, font, *s);
+    return x;
+}
+
+uint32_t ssd1306_text_width(const ssd1306_font_t *font, const char *s) {
+    uint32_t width=0;
+
+    for(; *s; ++s) {
+        const uint8_t ch=(uint8_t)*s;
+        if(ch>=font->first && ch<=font->last)
+            width+=font->widths[ch-font->first]+font->spacing;
+    }
+    return width>font->spacing?width-font->spacing:0;
+}
+
 void ssd1306_draw_char(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, char c) {
     ssd1306_draw_char_with_font(p, x, y, scale, font_8x5, c);
 }
@@ -227,6 +547,49 @@ void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, c
     ssd1306_draw_string_with_font(p, x, y, scale, font_8x5, s);
 }
 
+void ssd1306_draw_image(ssd1306_t *p, const ssd1306_image_t *img, int32_t x, int32_t y, ssd1306_sprite_mode_t mode) {
+    int32_t x0=x<0?0:x;
+    int32_t x1=x+img->width;
+    if(x1>SSD1306_WIDTH) x1=SSD1306_WIDTH;
+    if(x0>=x1 || y>=SSD1306_HEIGHT || y+img->height<=0) return;
+
+    const uint32_t parts=(img->height+7)>>3;
+    const uint32_t shift=y&7;
+    const int32_t page0=(y-(int32_t)shift)/8;
+    const uint32_t pages=(img->height+shift+7)>>3;
+    const uint32_t len=x1-x0;
+    const uint8_t *src=img->data+(x0-x);
+
+    for(uint32_t k=0; k<pages; ++k) {
+        const int32_t page=page0+k;
+        if(page<0)
+            continue;
+        if(page>=SSD1306_PAGES)
+            break;
+
+        // source pages that land on this page: cur shifted down, prev carrying into it
+        const uint8_t *cur=k<parts?src+k*img->width:NULL;
+        const uint8_t *prev=k>0&&shift?src+(k-1)*img->width:NULL;
+        uint8_t *row=p->buffer+page*SSD1306_WIDTH+x0;
+
+        uint8_t mask=0xFF;
+        if(k==0)
+            mask&=0xFF<<shift;
+        if(k==pages-1)
+            mask&=0xFF>>(7-((shift+img->height-1)&7));
+
+        if(mode==SSD1306_SPRITE_OPAQUE && mask==0xFF && !shift) {
+            memcpy(row, cur, len);
+            continue;
+        }
+
+        for(uint32_t i=0; i<len; ++i) {
+            const uint8_t v=(cur?cur[i]<<shift:0)|(prev?prev[i]>>(8-shift):0);
+            row[i]=mode==SSD1306_SPRITE_OPAQUE?(row[i]&~mask)|v:row[i]|v;
+        }
+    }
+}
+
 static inline uint32_t ssd1306_bmp_get_val(const uint8_t *data, const size_t offset, uint8_t size) {
     switch(size) {
     case 1:
@@ -290,17 +653,293 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
+#if SSD1306_SH1106
+/* sh1106 has no address windows: every page of the window is addressed on its own */
+static uint8_t *ssd1306_pack_window(ssd1306_t *p, uint8_t *tx, uint8_t page_lo, uint8_t page_hi, uint8_t col_lo, uint8_t col_hi) {
+    const uint8_t col=col_lo+SSD1306_COL_OFFSET;
+    const size_t span=col_hi-col_lo+1;
+
+    for(uint8_t page=page_lo; page<=page_hi; ++page) {
+        const size_t offset=page*SSD1306_WIDTH+col_lo;
+
+        *tx++=0x00;
+        *tx++=SH1106_SET_PAGE|page;
+        *tx++=SH1106_SET_COL_LO|(col&0x0F);
+        *tx++=SH1106_SET_COL_HI|(col>>4);
+        p->xfer_end[p->xfers++]=tx-p->txbuf;
+
+        *tx++=0x40;
+        memcpy(tx, p->buffer+offset, span);
+        memcpy(p->shadow+offset, p->buffer+offset, span);
+        tx+=span;
+        p->xfer_end[p->xfers++]=tx-p->txbuf;
+    }
+
+    ++p->stats.last_windows;
+
+    return tx;
+}
+#else
+static uint8_t *ssd1306_pack_window(ssd1306_t *p, uint8_t *tx, uint8_t page_lo, uint8_t page_hi, uint8_t col_lo, uint8_t col_hi) {
+    const uint8_t cmds[SSD1306_WINDOW_CMDS]= {SET_COL_ADDR, col_lo+SSD1306_COL_OFFSET, col_hi+SSD1306_COL_OFFSET, SET_PAGE_ADDR, page_lo, page_hi};
+
+    *tx++=0x00;
+    memcpy(tx, cmds, sizeof(cmds));
+    tx+=sizeof(cmds);
+    p->xfer_end[p->xfers++]=tx-p->txbuf;
+
+    // the window is filled page by page, so the spans are packed back to back
+    const size_t span=col_hi-col_lo+1;
+    *tx++=0x40;
+
+    for(uint8_t page=page_lo; page<=page_hi; ++page) {
+        const size_t offset=page*SSD1306_WIDTH+col_lo;
+        memcpy(tx, p->buffer+offset, span);
+        memcpy(p->shadow+offset, p->buffer+offset, span);
+        tx+=span;
+    }
+
+    p->xfer_end[p->xfers++]=tx-p->txbuf;
+    ++p->stats.last_windows;
+
+    return tx;
+}
+#endif
+
+static void ssd1306_pack_frame(ssd1306_t *p) {
+    uint8_t *tx=p->txbuf;
+    bool open=false;
+    uint8_t page_lo=0, page_hi=0, col_lo=0, col_hi=0;
+
+    p->xfers=0;
+    p->stats.last_windows=0;
+
+    for(uint8_t page=0; page<SSD1306_PAGES; ++page) {
+        const uint8_t *buf=p->buffer+page*SSD1306_WIDTH;
+        const uint8_t *shadow=p->shadow+page*SSD1306_WIDTH;
+        int32_t lo=0, hi=SSD1306_WIDTH-1;
+
+        if(p->damage_only && !p->full_refresh) {
+            lo=p->damage[2*page];
+            hi=p->damage[2*page+1];
+        }
+
+        if(!p->full_refresh) {
+            while(lo<=hi && buf[lo]==shadow[lo])
+                ++lo;
+            while(hi>=lo && buf[hi]==shadow[hi])
+                --hi;
+        }
+
+        if(lo>hi) { // page unchanged
+            if(open)
+                tx=ssd1306_pack_window(p, tx, page_lo, page_hi, col_lo, col_hi);
+            open=false;
+            continue;
+        }
+
+        if(open) {
+            // grow the open window if resending its clean bytes is cheaper than a new window
+            const uint8_t merged_lo=lo<col_lo?lo:col_lo;
+            const uint8_t merged_hi=hi>col_hi?hi:col_hi;
+            const uint32_t merged=(page-page_lo+1)*(merged_hi-merged_lo+1);
+            const uint32_t split=(page-page_lo)*(col_hi-col_lo+1)+(hi-lo+1)+SSD1306_WINDOW_COST;
+
+            if(merged<=split) {
+                page_hi=page;
+                col_lo=merged_lo;
+                col_hi=merged_hi;
+                continue;
+            }
+
+            tx=ssd1306_pack_window(p, tx, page_lo, page_hi, col_lo, col_hi);
+        }
+
+        open=true;
+        page_lo=page_hi=page;
+        col_lo=lo;
+        col_hi=hi;
+    }
+
+    if(open)
+        tx=ssd1306_pack_window(p, tx, page_lo, page_hi, col_lo, col_hi);
+
+    p->full_refresh=false;
+    ssd1306_reset_damage(p);
+    p->stats.last_bytes=tx-p->txbuf;
+    ++p->stats.frames;
+    p->stats.total_bytes+=p->stats.last_bytes;
+}
+
+static inline void ssd1306_account_bus_time(ssd1306_t *p) {
+    p->stats.last_bus_us=time_us_32()-p->xfer_start_us;
+    p->stats.total_bus_us+=p->stats.last_bus_us;
+}
+
+static void ssd1306_send_frame_blocking(ssd1306_t *p) {
+    uint16_t start=0;
+
+    for(uint16_t i=0; i<p->xfers; ++i) {
+        p->transport->write(p->transport_ctx, p->txbuf+start, p->xfer_end[i]-start);
+        start=p->xfer_end[i];
+    }
+
+    ssd1306_account_bus_time(p);
+}
+
+void ssd1306_transfer_done(ssd1306_t *p) {
+    ssd1306_account_bus_time(p);
+    p->busy=false;
+
+    if(p->done_cb)
+        p->done_cb(p->done_ctx);
+}
+
+void ssd1306_set_done_callback(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx) {
+    p->done_cb=done;
+    p->done_ctx=ctx;
+}
+
+void ssd1306_set_wait_callback(ssd1306_t *p, ssd1306_wait_cb_t wait, void *ctx) {
+    p->wait_cb=wait;
+    p->wait_ctx=ctx;
+}
+
+inline bool ssd1306_busy(ssd1306_t *p) {
+    return p->busy;
+}
+
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(p->busy)
+        return false;
+
+    ssd1306_pack_frame(p);
+
+    if(p->xfers==0) {
+        p->stats.last_bus_us=0;
+        return true;
+    }
+
+    p->xfer_start_us=time_us_32();
+
+    if(p->transport->write_async) {
+        p->busy=true;
+        if(p->transport->write_async(p->transport_ctx, p->txbuf, p->xfer_end, p->xfers))
+            return true;
+        p->busy=false;
+    }
+
+    ssd1306_send_frame_blocking(p);
+    return true;
+}
+
 void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+    ssd1306_wait_idle(p);
+    ssd1306_show_async(p);
+    ssd1306_wait_idle(p);
+}
+
+inline void ssd1306_invalidate(ssd1306_t *p) {
+    p->full_refresh=true;
+}
+
+void ssd1306_add_damage(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height) {
+    int32_t x0=x<0?0:x, y0=y<0?0:y;
+    int32_t x1=x+width, y1=y+height;
+    if(x1>SSD1306_WIDTH) x1=SSD1306_WIDTH;
+    if(y1>SSD1306_HEIGHT) y1=SSD1306_HEIGHT;
+
+    p->damage_only=true;
+    if(x0>=x1 || y0>=y1) return;
+
+    for(int32_t page=y0>>3; page<=(y1-1)>>3; ++page) {
+        if(x0<p->damage[2*page])
+            p->damage[2*page]=x0;
+        if(x1-1>p->damage[2*page+1])
+            p->damage[2*page+1]=x1-1;
     }
+}
+
+bool ssd1306_scroll_start(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page_start, uint8_t page_end, ssd1306_scroll_speed_t speed) {
+#if SSD1306_SH1106
+    (void)p; (void)dir; (void)page_start; (void)page_end; (void)speed;
+    return false;
+#else
+    if(page_start>page_end || page_end>=SSD1306_PAGES) return false;
+
+    // a new setup is only taken while the scroll is off
+    const uint8_t cmds[]= {
+        SET_SCROLL_OFF,
+        dir==SSD1306_SCROLL_LEFT?SET_HSCROLL_LEFT:SET_HSCROLL_RIGHT,
+        0x00,
+        page_start,
+        speed,
+        page_end,
+        0x00,
+        0xFF,
+        SET_SCROLL_ON
+    };
+
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+    p->scrolling=true;
+    return true;
+#endif
+}
+
+bool ssd1306_scroll_start_diagonal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page_start, uint8_t page_end, ssd1306_scroll_speed_t speed, uint8_t vertical_step) {
+#if SSD1306_SH1106
+    (void)p; (void)dir; (void)page_start; (void)page_end; (void)speed; (void)vertical_step;
+    return false;
+#else
+    if(page_start>page_end || page_end>=SSD1306_PAGES || vertical_step>=SSD1306_HEIGHT) return false;
+
+    const uint8_t cmds[]= {
+        SET_SCROLL_OFF,
+        // the whole display scrolls vertically
+        SET_VSCROLL_AREA,
+        0,
+        SSD1306_HEIGHT,
+        dir==SSD1306_SCROLL_LEFT?SET_VHSCROLL_LEFT:SET_VHSCROLL_RIGHT,
+        0x00,
+        page_start,
+        speed,
+        page_end,
+        vertical_step,
+        SET_SCROLL_ON
+    };
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+    p->scrolling=true;
+    return true;
+#endif
+}
+
+void ssd1306_scroll_stop(ssd1306_t *p) {
+    if(!p->scrolling)
+        return;
+
+    const uint8_t cmds[]= {SET_SCROLL_OFF};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+    p->scrolling=false;
+
+    // the scroll rotated the display RAM, it no longer matches the shadow
+    p->full_refresh=true;
+}
+
+inline void ssd1306_set_start_line(ssd1306_t *p, uint8_t line) {
+    const uint8_t cmds[]= {SET_DISP_START_LINE | (line & 0x3F)};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+}
 
-    *(p->buffer-1)=0x40;
+inline void ssd1306_set_display_offset(ssd1306_t *p, uint8_t offset) {
+    const uint8_t cmds[]= {SET_DISP_OFFSET, offset & 0x3F};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+}
+
+void ssd1306_get_stats(ssd1306_t *p, ssd1306_stats_t *stats) {
+    *stats=p->stats;
+}
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+void ssd1306_reset_stats(ssd1306_t *p) {
+    memset(&p->stats, 0, sizeof(p->stats));
 }
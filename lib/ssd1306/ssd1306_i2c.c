@@ -0,0 +1,316 @@
+/*
+
+MIT License
+
+Copyright (c) 2021 David Schramm
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pico/stdlib.h>
+#include <hardware/i2c.h>
+#include <hardware/gpio.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <string.h>
+
+#include "ssd1306.h"
+
+/* every wait on the bus is bounded: a byte takes at most 90 us (9 bits at 100 kHz) */
+#define BYTE_TIMEOUT_US 90
+#define BASE_TIMEOUT_US 1000
+#define TX_FIFO_DEPTH 16
+#define RECOVERY_PULSES 9
+#define RECOVERY_HALF_PERIOD_US 5
+
+/* i2c transports with DMA enabled, by i2c instance */
+static ssd1306_i2c_t *dma_transports[2];
+/* the shared DMA_IRQ_0 handler is installed while any transport uses DMA */
+static bool dma_irq_installed;
+
+static void ssd1306_i2c_dma_irq_handler(void);
+
+static inline uint32_t bus_timeout_us(size_t len) {
+    return BASE_TIMEOUT_US+len*BYTE_TIMEOUT_US;
+}
+
+inline static bool fancy_write(ssd1306_i2c_t *t, const uint8_t *src, size_t len) {
+    switch(i2c_write_timeout_us(t->i2c_i, t->address, src, len, false, bus_timeout_us(len))) {
+    case PICO_ERROR_GENERIC:
+        ++t->errors.nacks;
+        return false;
+    case PICO_ERROR_TIMEOUT:
+        ++t->errors.timeouts;
+        return false;
+    default:
+        return true;
+    }
+}
+
+/* counts and clears an abort of the DMA transfer, the frame it belonged to is incomplete */
+static void ssd1306_i2c_check_abort(ssd1306_i2c_t *t) {
+    i2c_hw_t *hw=i2c_get_hw(t->i2c_i);
+
+    if(!(hw->raw_intr_stat&I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))
+        return;
+
+    if(hw->tx_abrt_source&I2C_IC_TX_ABRT_SOURCE_ABRT_7B_ADDR_NOACK_BITS)
+        ++t->errors.nacks;
+    else
+        ++t->errors.aborts;
+    (void)hw->clr_tx_abrt;
+
+    ssd1306_invalidate(t->display);
+}
+
+/* frees a display holding SDA low in the middle of a byte: up to 9 clocks,
+   a start and a stop, then a fresh i2c block */
+static void ssd1306_i2c_recover(ssd1306_i2c_t *t) {
+    t->recover=false;
+
+    if(t->scl<0)
+        return;
+
+    i2c_deinit(t->i2c_i);
+
+    // open drain by hand: the pins are only ever driven low
+    gpio_init(t->sda);
+    gpio_init(t->scl);
+    gpio_pull_up(t->sda);
+    gpio_pull_up(t->scl);
+
+    for(int i=0; i<RECOVERY_PULSES && !gpio_get(t->sda); ++i) {
+        gpio_set_dir(t->scl, GPIO_OUT);
+        sleep_us(RECOVERY_HALF_PERIOD_US);
+        gpio_set_dir(t->scl, GPIO_IN);
+        sleep_us(RECOVERY_HALF_PERIOD_US);
+    }
+
+    gpio_set_dir(t->sda, GPIO_OUT);
+    sleep_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_dir(t->sda, GPIO_IN);
+    sleep_us(RECOVERY_HALF_PERIOD_US);
+
+    i2c_init(t->i2c_i, t->baudrate);
+    gpio_set_function(t->sda, GPIO_FUNC_I2C);
+    gpio_set_function(t->scl, GPIO_FUNC_I2C);
+
+    ++t->errors.recoveries;
+    ssd1306_invalidate(t->display);
+}
+
+static void ssd1306_i2c_wait_idle(void *ctx) {
+    ssd1306_i2c_t *t=ctx;
+
+    if(t->dma_chan<0)
+        return;
+
+    // DMA completes with up to a fifo worth of bytes still queued
+    i2c_hw_t *hw=i2c_get_hw(t->i2c_i);
+    uint32_t start=time_us_32();
+    while(!(hw->status&I2C_IC_STATUS_TFE_BITS) || (hw->status&I2C_IC_STATUS_MST_ACTIVITY_BITS)) {
+        if(time_us_32()-start>bus_timeout_us(TX_FIFO_DEPTH)) {
+            ++t->errors.timeouts;
+            t->recover=true;
+            break;
+        }
+        tight_loop_contents();
+    }
+
+    ssd1306_i2c_check_abort(t);
+}
+
+static bool ssd1306_i2c_write(void *ctx, const uint8_t *src, size_t len) {
+    ssd1306_i2c_t *t=ctx;
+
+    if(t->recover)
+        ssd1306_i2c_recover(t);
+
+    if(fancy_write(t, src, len))
+        return true;
+
+    // a single retry on a recovered bus, what the display holds is unknown either way
+    ssd1306_invalidate(t->display);
+    ssd1306_i2c_recover(t);
+    return fancy_write(t, src, len);
+}
+
+/* a stuck bus never drains the fifo: drop the frame and recover on the next transfer */
+static int64_t ssd1306_i2c_dma_timeout(alarm_id_t id, void *user_data) {
+    ssd1306_i2c_t *t=user_data;
+    (void)id;
+
+    t->alarm=0;
+    if(!dma_channel_is_busy(t->dma_chan))
+        return 0;   // completion interrupt pending
+
+    dma_channel_set_irq0_enabled(t->dma_chan, false);
+    dma_channel_abort(t->dma_chan);
+    dma_channel_acknowledge_irq0(t->dma_chan);
+    dma_channel_set_irq0_enabled(t->dma_chan, true);
+
+    ++t->errors.timeouts;
+    t->recover=true;
+    ssd1306_invalidate(t->display);
+    ssd1306_transfer_done(t->display);
+    return 0;
+}
+
+static bool ssd1306_i2c_write_async(void *ctx, const uint8_t *src, const uint16_t *end, uint16_t xfers) {
+    ssd1306_i2c_t *t=ctx;
+
+    if(t->dma_chan<0)
+        return false;
+
+    if(t->recover)
+        ssd1306_i2c_recover(t);
+
+    // the stop flag on the last byte of each transaction makes the controller
+    // issue a stop and restart with the same target address for the next one
+    uint16_t *w=t->dma_words;
+    uint16_t start=0;
+
+    for(uint16_t i=0; i<xfers; ++i) {
+        for(uint16_t j=start; j<end[i]-1; ++j)
+            *w++=src[j];
+        *w++=src[end[i]-1]|I2C_IC_DATA_CMD_STOP_BITS;
+        start=end[i];
+    }
+
+    i2c_hw_t *hw=i2c_get_hw(t->i2c_i);
+    if(hw->tar!=t->address) {
+        ssd1306_i2c_wait_idle(t);
+        hw->enable=0;
+        hw->tar=t->address;
+        hw->enable=1;
+    }
+
+    alarm_id_t alarm=add_alarm_in_us(bus_timeout_us(w-t->dma_words), ssd1306_i2c_dma_timeout, t, true);
+    t->alarm=alarm>0?alarm:0;
+
+    dma_channel_transfer_from_buffer_now(t->dma_chan, t->dma_words, w-t->dma_words);
+    return true;
+}
+
+static void ssd1306_i2c_deinit(void *ctx) {
+    ssd1306_i2c_t *t=ctx;
+
+    if(t->dma_chan<0)
+        return;
+
+    if(t->alarm) {
+        cancel_alarm(t->alarm);
+        t->alarm=0;
+    }
+    dma_channel_set_irq0_enabled(t->dma_chan, false);
+    dma_channel_unclaim(t->dma_chan);
+    dma_transports[i2c_get_index(t->i2c_i)]=NULL;
+    t->dma_chan=-1;
+
+    for(size_t i=0; i<count_of(dma_transports); ++i)
+        if(dma_transports[i]!=NULL)
+            return;
+
+    irq_remove_handler(DMA_IRQ_0, ssd1306_i2c_dma_irq_handler);
+    dma_irq_installed=false;
+}
+
+const ssd1306_transport_t ssd1306_i2c_transport= {
+    .write=ssd1306_i2c_write,
+    .write_async=ssd1306_i2c_write_async,
+    .wait_idle=ssd1306_i2c_wait_idle,
+    .deinit=ssd1306_i2c_deinit,
+};
+
+static void ssd1306_i2c_dma_irq_handler(void) {
+    for(size_t i=0; i<count_of(dma_transports); ++i) {
+        ssd1306_i2c_t *t=dma_transports[i];
+        if(t==NULL || !dma_channel_get_irq0_status(t->dma_chan))
+            continue;
+
+        dma_channel_acknowledge_irq0(t->dma_chan);
+        if(t->alarm) {
+            cancel_alarm(t->alarm);
+            t->alarm=0;
+        }
+        ssd1306_i2c_check_abort(t);
+        ssd1306_transfer_done(t->display);
+    }
+}
+
+bool ssd1306_init(ssd1306_t *p, uint8_t address, i2c_inst_t *i2c_instance) {
+    p->i2c.i2c_i=i2c_instance;
+    p->i2c.address=address;
+    p->i2c.dma_chan=-1;
+    p->i2c.alarm=0;
+    p->i2c.sda=-1;
+    p->i2c.scl=-1;
+    p->i2c.baudrate=0;
+    p->i2c.recover=false;
+    memset(&p->i2c.errors, 0, sizeof(p->i2c.errors));
+    p->i2c.display=p;
+
+    return ssd1306_init_with_transport(p, &ssd1306_i2c_transport, &p->i2c);
+}
+
+void ssd1306_i2c_set_recovery(ssd1306_t *p, uint sda, uint scl, uint baudrate) {
+    p->i2c.sda=sda;
+    p->i2c.scl=scl;
+    p->i2c.baudrate=baudrate;
+}
+
+void ssd1306_i2c_get_errors(ssd1306_t *p, ssd1306_i2c_errors_t *errors) {
+    *errors=p->i2c.errors;
+}
+
+bool ssd1306_dma_init(ssd1306_t *p, ssd1306_done_cb_t done, void *ctx) {
+    ssd1306_i2c_t *t=&p->i2c;
+
+    if(p->transport!=&ssd1306_i2c_transport)
+        return false;
+
+    ssd1306_set_done_callback(p, done, ctx);
+
+    if(t->dma_chan>=0)
+        return true;
+
+    int chan=dma_claim_unused_channel(false);
+    if(chan<0)
+        return false;
+
+    dma_channel_config c=dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(t->i2c_i, true));
+    dma_channel_configure(chan, &c, &i2c_get_hw(t->i2c_i)->data_cmd, t->dma_words, 0, false);
+
+    t->dma_chan=chan;
+
+    dma_transports[i2c_get_index(t->i2c_i)]=t;
+    dma_channel_set_irq0_enabled(chan, true);
+
+    if(!dma_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, ssd1306_i2c_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        dma_irq_installed=true;
+    }
+
+    return true;
+}
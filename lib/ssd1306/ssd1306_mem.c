@@ -0,0 +1,203 @@
+/*
+
+MIT License
+
+Copyright (c) 2021 David Schramm
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ssd1306_mem.h"
+
+/* argument bytes following each command */
+static uint8_t ssd1306_mem_cmd_args(uint8_t cmd) {
+    switch(cmd) {
+    case SET_COL_ADDR:
+    case SET_PAGE_ADDR:
+    case SET_VSCROLL_AREA:
+        return 2;
+    case SET_HSCROLL_RIGHT:
+    case SET_HSCROLL_LEFT:
+        return 6;
+    case SET_VHSCROLL_RIGHT:
+    case SET_VHSCROLL_LEFT:
+        return 5;
+    case SET_CONTRAST:
+    case SET_MEM_ADDR:
+    case SET_MUX_RATIO:
+    case SET_DISP_OFFSET:
+    case SET_COM_PIN_CFG:
+    case SET_DISP_CLK_DIV:
+    case SET_PRECHARGE:
+    case SET_VCOM_DESEL:
+    case SET_CHARGE_PUMP:
+    case 0xAD:                  // sh1106 DC-DC control
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void ssd1306_mem_exec(ssd1306_mem_t *m) {
+    const uint8_t *c=m->cmd;
+
+    switch(c[0]) {
+    case SET_COL_ADDR:
+        m->col_start=m->col=c[1]%SSD1306_MEM_COLUMNS;
+        m->col_end=c[2]%SSD1306_MEM_COLUMNS;
+        return;
+    case SET_PAGE_ADDR:
+        m->page_start=m->page=c[1]%SSD1306_MEM_PAGES;
+        m->page_end=c[2]%SSD1306_MEM_PAGES;
+        return;
+    case SET_MEM_ADDR:
+        m->mem_mode=c[1]&3;
+        return;
+    case SET_CONTRAST:
+        m->contrast=c[1];
+        return;
+    case SET_DISP:
+    case SET_DISP|0x01:
+        m->display_on=c[0]&1;
+        return;
+    case SET_NORM_INV:
+    case SET_NORM_INV|0x01:
+        m->inverted=c[0]&1;
+        return;
+    case SET_DISP_OFFSET:
+        m->display_offset=c[1]&0x3F;
+        return;
+    case SET_SCROLL_ON:
+    case SET_SCROLL_OFF:
+        m->scrolling=c[0]==SET_SCROLL_ON;
+        return;
+    }
+
+    if((c[0]&0xC0)==SET_DISP_START_LINE)
+        m->start_line=c[0]&0x3F;
+    else if(m->mem_mode==2 && (c[0]&0xF8)==0xB0)    // page addressing: page start
+        m->page=c[0]&7;
+    else if(m->mem_mode==2 && c[0]<0x10)            // page addressing: column low nibble
+        m->col=(m->col&0xF0)|c[0];
+    else if(m->mem_mode==2 && c[0]<0x20)            // page addressing: column high nibble
+        m->col=((m->col&0x0F)|((c[0]&0x0F)<<4))%SSD1306_MEM_COLUMNS;
+}
+
+static void ssd1306_mem_command(ssd1306_mem_t *m, uint8_t b) {
+    if(m->cmd_len==0)
+        m->cmd_need=1+ssd1306_mem_cmd_args(b);
+
+    m->cmd[m->cmd_len++]=b;
+    if(m->cmd_len<m->cmd_need)
+        return;
+
+    ssd1306_mem_exec(m);
+    m->cmd_len=0;
+}
+
+static void ssd1306_mem_data(ssd1306_mem_t *m, uint8_t b) {
+    m->ram[m->page][m->col]=b;
+
+    if(m->mem_mode==2) {                            // page addressing wraps in the page
+        m->col=(m->col+1)%SSD1306_MEM_COLUMNS;
+        return;
+    }
+
+    if(m->mem_mode==1) {                            // vertical addressing
+        if(m->page++<m->page_end)
+            return;
+        m->page=m->page_start;
+        m->col=m->col<m->col_end?m->col+1:m->col_start;
+        return;
+    }
+
+    if(m->col++<m->col_end)                         // horizontal addressing
+        return;
+    m->col=m->col_start;
+    m->page=m->page<m->page_end?m->page+1:m->page_start;
+}
+
+static bool ssd1306_mem_write(void *ctx, const uint8_t *src, size_t len) {
+    ssd1306_mem_t *m=ctx;
+
+    ++m->transactions;
+    m->bytes+=len;
+
+    // control byte: bit 6 selects data, bit 7 (Co) means a single byte follows before the next control byte
+    size_t i=0;
+    while(i<len) {
+        const uint8_t ctrl=src[i++];
+        const size_t n=ctrl&0x80?1:len-i;
+
+        for(size_t j=0; j<n && i<len; ++j, ++i) {
+            if(ctrl&0x40)
+                ssd1306_mem_data(m, src[i]);
+            else
+                ssd1306_mem_command(m, src[i]);
+        }
+    }
+
+    return true;
+}
+
+const ssd1306_transport_t ssd1306_mem_transport= {
+    .write=ssd1306_mem_write,
+};
+
+void ssd1306_mem_init(ssd1306_mem_t *m) {
+    memset(m, 0, sizeof(*m));
+    m->mem_mode=SSD1306_SH1106?2:0;     // sh1106 only has page addressing
+    m->col_end=SSD1306_MEM_COLUMNS-1;
+    m->page_end=SSD1306_MEM_PAGES-1;
+    m->contrast=0x7F;
+}
+
+bool ssd1306_mem_get_pixel(const ssd1306_mem_t *m, uint32_t x, uint32_t y) {
+    if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT)
+        return false;
+
+    // the start line picks the RAM row shown on the first line, wrapping at the end of the RAM
+    const uint32_t row=(y+m->start_line)%(SSD1306_MEM_PAGES*8);
+
+    return (m->ram[row>>3][x+SSD1306_COL_OFFSET]>>(row&7))&1;
+}
+
+bool ssd1306_mem_write_pbm(const ssd1306_mem_t *m, const char *path) {
+    FILE *f=fopen(path, "wb");
+    if(f==NULL)
+        return false;
+
+    fprintf(f, "P4\n%u %u\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+
+    // PBM: rows MSB first, 1 is black
+    for(uint32_t y=0; y<SSD1306_HEIGHT; ++y) {
+        for(uint32_t x=0; x<SSD1306_WIDTH; x+=8) {
+            uint8_t b=0;
+            for(uint32_t k=0; k<8; ++k)
+                if(x+k>=SSD1306_WIDTH || !ssd1306_mem_get_pixel(m, x+k, y))
+                    b|=0x80>>k;
+            fputc(b, f);
+        }
+    }
+
+    return fclose(f)==0;
+}
@@ -0,0 +1,233 @@
+/*
+
+MIT License
+
+Copyright (c) 2021 David Schramm
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pico/stdlib.h>
+#include <hardware/pio.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+
+#include "ssd1306_pio.h"
+#include "ssd1306_pio.pio.h"
+
+/* fifo word layouts, see ssd1306_pio.pio */
+#define I2C_START (1u<<31)
+#define I2C_STOP (1u<<22)
+#define I2C_BYTE(b) ((uint32_t)(uint8_t)~(b)<<23)
+#define SPI_DATA (1u<<31)
+#define SPI_BYTE(b) ((uint32_t)(uint8_t)(b)<<23)
+
+/* pio transports, by PIO instance and state machine */
+static ssd1306_pio_t *dma_transports[2*NUM_PIO_STATE_MACHINES];
+/* the shared DMA_IRQ_1 handler is installed while any transport is claimed */
+static bool dma_irq_installed;
+
+static void ssd1306_pio_dma_irq_handler(void);
+
+static inline size_t transport_index(const ssd1306_pio_t *t) {
+    return pio_get_index(t->pio)*NUM_PIO_STATE_MACHINES+t->sm;
+}
+
+static inline const pio_program_t *transport_program(const ssd1306_pio_t *t) {
+    return t->bus==SSD1306_PIO_I2C?&ssd1306_pio_i2c_program:&ssd1306_pio_spi_program;
+}
+
+static uint32_t *pack_words(const ssd1306_pio_t *t, uint32_t *w, const uint8_t *src, size_t len) {
+    if(t->bus==SSD1306_PIO_I2C) {
+        *w++=I2C_START|I2C_BYTE(t->address<<1);
+        for(size_t i=0; i<len; ++i)
+            *w++=I2C_BYTE(src[i]);
+        w[-1]|=I2C_STOP;
+        return w;
+    }
+
+    // on spi the control byte only selects the D/C level
+    const uint32_t dc=(src[0]&0x40)?SPI_DATA:0;
+    for(size_t i=1; i<len; ++i)
+        *w++=dc|SPI_BYTE(src[i]);
+    return w;
+}
+
+static void ssd1306_pio_wait_idle(void *ctx) {
+    ssd1306_pio_t *t=ctx;
+    const uint32_t stall=1u<<(PIO_FDEBUG_TXSTALL_LSB+t->sm);
+
+    while(dma_channel_is_busy(t->dma_chan))
+        tight_loop_contents();
+
+    // DMA completes with up to a fifo worth of words still queued, the
+    // state machine stalls on the empty fifo once the last one is out
+    t->pio->fdebug=stall;
+    while(!pio_sm_is_tx_fifo_empty(t->pio, t->sm) || !(t->pio->fdebug&stall))
+        tight_loop_contents();
+}
+
+static bool ssd1306_pio_write(void *ctx, const uint8_t *src, size_t len) {
+    ssd1306_pio_t *t=ctx;
+
+    ssd1306_pio_wait_idle(t);
+
+    const uint32_t *end=pack_words(t, t->words, src, len);
+    for(const uint32_t *w=t->words; w<end; ++w)
+        pio_sm_put_blocking(t->pio, t->sm, *w);
+
+    ssd1306_pio_wait_idle(t);
+    return true;
+}
+
+static bool ssd1306_pio_write_async(void *ctx, const uint8_t *src, const uint16_t *end, uint16_t xfers) {
+    ssd1306_pio_t *t=ctx;
+    uint32_t *w=t->words;
+    uint16_t start=0;
+
+    for(uint16_t i=0; i<xfers; ++i) {
+        w=pack_words(t, w, src+start, end[i]-start);
+        start=end[i];
+    }
+
+    if(w==t->words)
+        return false;
+
+    dma_channel_transfer_from_buffer_now(t->dma_chan, t->words, w-t->words);
+    return true;
+}
+
+static void ssd1306_pio_deinit(void *ctx) {
+    ssd1306_pio_t *t=ctx;
+
+    pio_sm_set_enabled(t->pio, t->sm, false);
+    pio_remove_program(t->pio, transport_program(t), t->offset);
+    pio_sm_unclaim(t->pio, t->sm);
+
+    dma_channel_set_irq1_enabled(t->dma_chan, false);
+    dma_channel_unclaim(t->dma_chan);
+    dma_transports[transport_index(t)]=NULL;
+    t->dma_chan=-1;
+
+    for(size_t i=0; i<count_of(dma_transports); ++i)
+        if(dma_transports[i]!=NULL)
+            return;
+
+    irq_remove_handler(DMA_IRQ_1, ssd1306_pio_dma_irq_handler);
+    dma_irq_installed=false;
+}
+
+const ssd1306_transport_t ssd1306_pio_transport= {
+    .write=ssd1306_pio_write,
+    .write_async=ssd1306_pio_write_async,
+    .wait_idle=ssd1306_pio_wait_idle,
+    .deinit=ssd1306_pio_deinit,
+};
+
+static void ssd1306_pio_dma_irq_handler(void) {
+    for(size_t i=0; i<count_of(dma_transports); ++i) {
+        ssd1306_pio_t *t=dma_transports[i];
+        if(t==NULL || !dma_channel_get_irq1_status(t->dma_chan))
+            continue;
+
+        dma_channel_acknowledge_irq1(t->dma_chan);
+        ssd1306_transfer_done(t->display);
+    }
+}
+
+/* claims a state machine and a DMA channel and loads the program of t->bus */
+static bool ssd1306_pio_claim(ssd1306_pio_t *t, PIO pio) {
+    const pio_program_t *program=transport_program(t);
+
+    if(!pio_can_add_program(pio, program))
+        return false;
+
+    int sm=pio_claim_unused_sm(pio, false);
+    if(sm<0)
+        return false;
+
+    int chan=dma_claim_unused_channel(false);
+    if(chan<0) {
+        pio_sm_unclaim(pio, sm);
+        return false;
+    }
+
+    t->pio=pio;
+    t->sm=sm;
+    t->offset=pio_add_program(pio, program);
+    t->dma_chan=chan;
+
+    dma_channel_config c=dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(chan, &c, &pio->txf[sm], t->words, 0, false);
+
+    dma_transports[transport_index(t)]=t;
+    dma_channel_set_irq1_enabled(chan, true);
+
+    if(!dma_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_1, ssd1306_pio_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+        dma_irq_installed=true;
+    }
+
+    return true;
+}
+
+bool ssd1306_init_pio_i2c(ssd1306_t *p, ssd1306_pio_t *t, PIO pio, uint sda, uint scl, uint8_t address, uint32_t baudrate) {
+    t->bus=SSD1306_PIO_I2C;
+    t->address=address;
+    t->display=p;
+
+    if(!ssd1306_pio_claim(t, pio))
+        return false;
+
+    ssd1306_pio_i2c_program_init(pio, t->sm, t->offset, sda, scl, baudrate);
+
+    return ssd1306_init_with_transport(p, &ssd1306_pio_transport, t);
+}
+
+bool ssd1306_init_pio_spi(ssd1306_t *p, ssd1306_pio_t *t, PIO pio, uint mosi, uint sck, uint dc, uint cs, int rst, uint32_t baudrate) {
+    t->bus=SSD1306_PIO_SPI;
+    t->address=0;
+    t->display=p;
+
+    if(!ssd1306_pio_claim(t, pio))
+        return false;
+
+    gpio_init(cs);
+    gpio_set_dir(cs, GPIO_OUT);
+    gpio_put(cs, 0);
+
+    if(rst>=0) {
+        gpio_init(rst);
+        gpio_set_dir(rst, GPIO_OUT);
+        gpio_put(rst, 1);
+        sleep_ms(1);
+        gpio_put(rst, 0);
+        sleep_ms(10);
+        gpio_put(rst, 1);
+    }
+
+    ssd1306_pio_spi_program_init(pio, t->sm, t->offset, mosi, sck, dc, baudrate);
+
+    return ssd1306_init_with_transport(p, &ssd1306_pio_transport, t);
+}
@@ -0,0 +1,72 @@
+#include "alien_fleet.h"
+
+#define MASK(n) (0xffffffffu >> (32 - (n)))  // n bits baixos, 1 <= n <= 32
+
+void alien_fleet_init(AlienFleet *fleet, const AlienFormation *formation, int x, int y) {
+    int rows = formation->rows;
+    int cols = formation->cols;
+
+    fleet->formation = *formation;
+    fleet->x = x;
+    fleet->y = y;
+    for (int r = 0; r < rows; ++r)
+        fleet->alive[r] = MASK(cols);
+    for (int c = 0; c < cols; ++c)
+        fleet->column_rows[c] = MASK(rows);
+    fleet->columns = MASK(cols);
+    fleet->rows = MASK(rows);
+    fleet->count = rows * cols;
+    fleet->left = 0;
+    fleet->right = (cols - 1) * formation->spacing_x + ALIEN_WIDTH;
+    fleet->bottom = (rows - 1) * formation->spacing_y + ALIEN_HEIGHT;
+}
+
+void alien_fleet_kill(AlienFleet *fleet, int row, int col) {
+    if (!alien_fleet_alive(fleet, row, col))
+        return;
+
+    fleet->alive[row] &= ~(1u << col);
+    fleet->column_rows[col] &= ~(1u << row);
+    fleet->count--;
+
+    // Os extremos só mudam quando uma linha ou coluna inteira esvazia
+    if (fleet->alive[row] == 0) {
+        fleet->rows &= ~(1u << row);
+        if (fleet->rows)
+            fleet->bottom = (31 - __builtin_clz(fleet->rows)) * fleet->formation.spacing_y + ALIEN_HEIGHT;
+    }
+    if (fleet->column_rows[col] == 0) {
+        fleet->columns &= ~(1u << col);
+        if (fleet->columns) {
+            fleet->left = __builtin_ctz(fleet->columns) * fleet->formation.spacing_x;
+            fleet->right = (31 - __builtin_clz(fleet->columns)) * fleet->formation.spacing_x + ALIEN_WIDTH;
+        }
+    }
+}
+
+bool alien_fleet_hit(AlienFleet *fleet, int x, int y) {
+    int dx = x - fleet->x;
+    int dy = y - fleet->y;
+
+    if (dx < 0 || dy < 0)
+        return false;
+
+    const AlienFormation *formation = &fleet->formation;
+    int col = dx / formation->spacing_x;
+    int row = dy / formation->spacing_y;
+
+    // Caiu no espaço entre duas colunas
+    if (col >= formation->cols || dx - col * formation->spacing_x >= ALIEN_WIDTH)
+        return false;
+
+    // Com spacing_y menor que ALIEN_HEIGHT (nível de estresse) as fileiras se
+    // sobrepõem e o ponto pode estar também na parte de baixo das de cima.
+    // A de baixo, que o tiro do jogador alcança primeiro, tem preferência
+    for (int r = row; r >= 0 && dy - r * formation->spacing_y < ALIEN_HEIGHT; --r) {
+        if (r < formation->rows && alien_fleet_alive(fleet, r, col)) {
+            alien_fleet_kill(fleet, r, col);
+            return true;
+        }
+    }
+    return false;
+}
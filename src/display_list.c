@@ -0,0 +1,241 @@
+#include <string.h>
+#include "display_list.h"
+
+void display_list_reset(DisplayList *dl) {
+    dl->count = 0;
+    dl->rect_count = 0;
+    dl->full_redraw = true;
+}
+
+static int add_node(DisplayList *dl, DisplayNodeKind_e kind, int16_t x, int16_t y, bool visible) {
+    if (dl->count >= DISPLAY_LIST_MAX_NODES)
+        return -1;
+
+    DisplayNode *n = &dl->nodes[dl->count];
+    memset(n, 0, sizeof(*n));
+    n->kind = kind;
+    n->x = x;
+    n->y = y;
+    n->visible = visible;
+    n->changed = true;
+    return dl->count++;
+}
+
+int display_list_add_sprite(DisplayList *dl, const ssd1306_sprite_t *sprite, int16_t x, int16_t y, bool visible) {
+    int node = add_node(dl, DL_NODE_SPRITE, x, y, visible);
+    if (node >= 0)
+        dl->nodes[node].sprite = sprite;
+    return node;
+}
+
+int display_list_add_text(DisplayList *dl, const ssd1306_font_t *font, int16_t x, int16_t y, const char *text) {
+    int node = add_node(dl, DL_NODE_TEXT, x, y, true);
+    if (node >= 0) {
+        dl->nodes[node].font = font;
+        strncpy(dl->nodes[node].text, text, DISPLAY_LIST_TEXT_LEN - 1);
+    }
+    return node;
+}
+
+int display_list_add_image(DisplayList *dl, const ssd1306_image_t *image, int16_t x, int16_t y) {
+    int node = add_node(dl, DL_NODE_IMAGE, x, y, true);
+    if (node >= 0)
+        dl->nodes[node].image = image;
+    return node;
+}
+
+void display_list_touch(DisplayList *dl, int node) {
+    dl->nodes[node].changed = true;
+}
+
+void display_list_set(DisplayList *dl, int node, int16_t x, int16_t y, bool visible) {
+    DisplayNode *n = &dl->nodes[node];
+
+    if (n->x == x && n->y == y && n->visible == visible)
+        return;
+    n->x = x;
+    n->y = y;
+    n->visible = visible;
+    n->changed = true;
+}
+
+void display_list_hide(DisplayList *dl, int node) {
+    DisplayNode *n = &dl->nodes[node];
+
+    if (!n->visible)
+        return;
+    n->visible = false;
+    n->changed = true;
+}
+
+void display_list_set_text(DisplayList *dl, int node, const char *text) {
+    DisplayNode *n = &dl->nodes[node];
+
+    if (strncmp(n->text, text, DISPLAY_LIST_TEXT_LEN - 1) == 0)
+        return;
+    strncpy(n->text, text, DISPLAY_LIST_TEXT_LEN - 1);
+    n->changed = true;
+}
+
+// Área ocupada pelo nó na posição atual, recortada à tela
+static DisplayRect node_rect(const DisplayNode *n) {
+    DisplayRect r = {n->x, n->y, n->x, n->y};
+
+    if (n->kind == DL_NODE_SPRITE) {
+        r.x1 += n->sprite->width;
+        r.y1 += n->sprite->height;
+    } else if (n->kind == DL_NODE_IMAGE) {
+        r.x1 += n->image->width;
+        r.y1 += n->image->height;
+    } else {
+        r.x1 += ssd1306_text_width(n->font, n->text);
+        r.y1 += n->font->height;
+    }
+
+    if (r.x0 < 0) r.x0 = 0;
+    if (r.y0 < 0) r.y0 = 0;
+    if (r.x1 > SSD1306_WIDTH) r.x1 = SSD1306_WIDTH;
+    if (r.y1 > SSD1306_HEIGHT) r.y1 = SSD1306_HEIGHT;
+    return r;
+}
+
+static bool rect_empty(const DisplayRect *r) {
+    return r->x0 >= r->x1 || r->y0 >= r->y1;
+}
+
+static bool rects_touch(const DisplayRect *a, const DisplayRect *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static bool rect_contains(const DisplayRect *a, const DisplayRect *b) {
+    return a->x0 <= b->x0 && a->y0 <= b->y0 && a->x1 >= b->x1 && a->y1 >= b->y1;
+}
+
+static void rect_union(DisplayRect *a, const DisplayRect *b) {
+    if (b->x0 < a->x0) a->x0 = b->x0;
+    if (b->y0 < a->y0) a->y0 = b->y0;
+    if (b->x1 > a->x1) a->x1 = b->x1;
+    if (b->y1 > a->y1) a->y1 = b->y1;
+}
+
+// Junta o retângulo a um que ele toque; com a lista cheia, redesenha a tela toda
+static void add_rect(DisplayList *dl, DisplayRect r) {
+    if (rect_empty(&r) || dl->full_redraw)
+        return;
+
+    for (uint8_t i = 0; i < dl->rect_count; ++i) {
+        if (rects_touch(&dl->rects[i], &r)) {
+            rect_union(&dl->rects[i], &r);
+            return;
+        }
+    }
+
+    if (dl->rect_count < DISPLAY_LIST_MAX_RECTS)
+        dl->rects[dl->rect_count++] = r;
+    else
+        dl->full_redraw = true;
+}
+
+// Imagens opacas são redesenhadas inteiras e apagariam o que está por cima
+// fora da área suja; a área passa a cobrir a imagem toda
+static void cover_images(DisplayList *dl) {
+    bool grown = true;
+
+    while (grown && !dl->full_redraw) {
+        grown = false;
+        for (uint8_t i = 0; i < dl->count; ++i) {
+            const DisplayNode *n = &dl->nodes[i];
+            if (n->kind != DL_NODE_IMAGE || !n->drawn || n->changed)
+                continue;
+
+            bool touched = false, covered = false;
+            for (uint8_t r = 0; r < dl->rect_count; ++r) {
+                touched |= rects_touch(&dl->rects[r], &n->drawn_rect);
+                covered |= rect_contains(&dl->rects[r], &n->drawn_rect);
+            }
+            if (touched && !covered) {
+                add_rect(dl, n->drawn_rect);
+                grown = true;
+            }
+        }
+    }
+}
+
+static void draw_node(ssd1306_t *oled, DisplayNode *n) {
+    switch (n->kind) {
+        case DL_NODE_SPRITE:
+            ssd1306_draw_sprite(oled, n->sprite, n->x, n->y, SSD1306_SPRITE_TRANSPARENT);
+            break;
+        case DL_NODE_IMAGE:
+            ssd1306_draw_image(oled, n->image, n->x, n->y, SSD1306_SPRITE_OPAQUE);
+            break;
+        case DL_NODE_TEXT:
+            ssd1306_draw_text(oled, n->x, n->y, n->font, n->text);
+            break;
+    }
+}
+
+uint8_t display_list_render(DisplayList *dl, ssd1306_t *oled) {
+    dl->rect_count = 0;
+
+    for (uint8_t i = 0; i < dl->count && !dl->full_redraw; ++i) {
+        DisplayNode *n = &dl->nodes[i];
+        if (!n->changed)
+            continue;
+        if (n->drawn)
+            add_rect(dl, n->drawn_rect);
+        if (n->visible)
+            add_rect(dl, node_rect(n));
+    }
+
+    if (dl->full_redraw) {
+        // Troca de tela ou movimento demais para valer o controle por área
+        ssd1306_clear(oled);
+        ssd1306_add_damage(oled, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT);
+        dl->rects[0] = (DisplayRect){0, 0, SSD1306_WIDTH, SSD1306_HEIGHT};
+        dl->rect_count = 1;
+    } else {
+        // Uniões podem ter passado a tocar outros retângulos
+        for (uint8_t i = 0; i < dl->rect_count; ++i)
+            for (uint8_t j = i + 1; j < dl->rect_count; ++j)
+                if (rects_touch(&dl->rects[i], &dl->rects[j])) {
+                    rect_union(&dl->rects[i], &dl->rects[j]);
+                    dl->rects[j--] = dl->rects[--dl->rect_count];
+                }
+        cover_images(dl);
+
+        for (uint8_t r = 0; r < dl->rect_count; ++r) {
+            const DisplayRect *rect = &dl->rects[r];
+            ssd1306_fill_rect(oled, rect->x0, rect->y0, rect->x1 - rect->x0, rect->y1 - rect->y0, SSD1306_ROP_AND);
+            ssd1306_add_damage(oled, rect->x0, rect->y0, rect->x1 - rect->x0, rect->y1 - rect->y0);
+        }
+    }
+
+    // Redesenha os nós visíveis que cruzam alguma área apagada
+    for (uint8_t i = 0; i < dl->count; ++i) {
+        DisplayNode *n = &dl->nodes[i];
+
+        // Nós parados mantêm a área do último desenho
+        if (n->changed || dl->full_redraw) {
+            n->changed = false;
+            n->drawn = false;
+            if (n->visible) {
+                n->drawn_rect = node_rect(n);
+                n->drawn = !rect_empty(&n->drawn_rect);
+            }
+        }
+
+        if (!n->drawn)
+            continue;
+
+        for (uint8_t r = 0; r < dl->rect_count; ++r) {
+            if (rects_touch(&dl->rects[r], &n->drawn_rect)) {
+                draw_node(oled, n);
+                break;
+            }
+        }
+    }
+
+    dl->full_redraw = false;
+    return dl->rect_count;
+}
@@ -3,6 +3,7 @@
 #include "hardware/adc.h"
 #include "hardware/i2c.h"
 #include "game.h"
+#include "ssd1306_pio.h"
 #include "buzzer.h"
 #include "rgb.h"
 
@@ -12,6 +13,27 @@
 #define I2C_SCL_PIN 15
 #define I2C_PORT i2c1
 #define OLED_ADDRESS 0x3C
+#define OLED_I2C_HZ (400 * 1000)
+
+// Transporte do display, escolhido no build (-DOLED_TRANSPORT=...)
+#define OLED_TRANSPORT_I2C 1        // bloco I2C do RP2040 a 400 kHz
+#define OLED_TRANSPORT_PIO_I2C 2    // I2C por PIO, acima do limite do bloco
+#define OLED_TRANSPORT_PIO_SPI 3    // módulos SPI de 4 fios, por PIO
+#ifndef OLED_TRANSPORT
+#define OLED_TRANSPORT OLED_TRANSPORT_I2C
+#endif
+
+#ifndef OLED_PIO_I2C_HZ
+#define OLED_PIO_I2C_HZ (1000 * 1000)
+#endif
+#ifndef OLED_SPI_HZ
+#define OLED_SPI_HZ (10 * 1000 * 1000)
+#endif
+#define SPI_MOSI_PIN 19
+#define SPI_SCK_PIN 18
+#define SPI_DC_PIN 20
+#define SPI_CS_PIN 17
+#define SPI_RST_PIN 16
 
 /**
  * @brief Inicializa o joystick (ADC) e os botões (GPIO).
@@ -28,15 +50,29 @@ void init_joystick_and_buttons(void) {
 }
 
 /**
- * @brief Inicializa o display OLED (I2C).
+ * @brief Inicializa o display OLED no transporte escolhido por OLED_TRANSPORT.
  */
 void init_oled(void) {
-    i2c_init(I2C_PORT, 400 * 1000);
+#if OLED_TRANSPORT == OLED_TRANSPORT_I2C
+    i2c_init(I2C_PORT, OLED_I2C_HZ);
     gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA_PIN);
     gpio_pull_up(I2C_SCL_PIN);
-    if (!ssd1306_init(&oled_display, OLED_WIDTH, OLED_HEIGHT, OLED_ADDRESS, I2C_PORT)) {
+    bool ok = ssd1306_init(&oled_display, OLED_ADDRESS, I2C_PORT);
+    // Barramento travado (display segurando o SDA) é destravado pelo próprio driver
+    ssd1306_i2c_set_recovery(&oled_display, I2C_SDA_PIN, I2C_SCL_PIN, OLED_I2C_HZ);
+#else
+    static ssd1306_pio_t oled_pio;
+#if OLED_TRANSPORT == OLED_TRANSPORT_PIO_I2C
+    bool ok = ssd1306_init_pio_i2c(&oled_display, &oled_pio, pio0, I2C_SDA_PIN, I2C_SCL_PIN,
+                                   OLED_ADDRESS, OLED_PIO_I2C_HZ);
+#else
+    bool ok = ssd1306_init_pio_spi(&oled_display, &oled_pio, pio0, SPI_MOSI_PIN, SPI_SCK_PIN,
+                                   SPI_DC_PIN, SPI_CS_PIN, SPI_RST_PIN, OLED_SPI_HZ);
+#endif
+#endif
+    if (!ok) {
         while (1);
     }
     ssd1306_clear(&oled_display);
@@ -0,0 +1,117 @@
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/systick.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tickless_idle.h"
+
+#define TICK_US (1000000u / configTICK_RATE_HZ)
+#define TICKLESS_MIN_RELOAD_US 2    // recarga mínima do SysTick ao religar, para não perder o tick
+
+static int alarm_num = -1;
+static uint32_t cycles_per_us;
+static uint32_t cycles_per_tick;
+static uint64_t slept_us;           // só a idle task escreve, e ela só roda com as outras bloqueadas
+
+// O alarme só tira o núcleo do WFI: a conta do tempo dormido é feita na volta
+static void tickless_alarm(uint alarm) {
+    (void)alarm;
+}
+
+void tickless_idle_init(void) {
+    cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+    cycles_per_tick = clock_get_hz(clk_sys) / configTICK_RATE_HZ;
+    alarm_num = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, tickless_alarm);
+}
+
+uint64_t tickless_idle_slept_us(void) {
+    return slept_us;
+}
+
+#if configUSE_TICKLESS_IDLE == 1
+
+/*
+ * Substitui a versão fraca do port, que dorme com o próprio SysTick: com 24
+ * bits a 125 MHz ele não passa de ~134 ms. Aqui o SysTick fica parado e
+ * quem acorda é um alarme do timer de 64 bits em microssegundos, então o
+ * sono dura o que o kernel pedir. Na volta, o tempo medido no timer vira
+ * ticks (vTaskStepTick) e o SysTick é religado alinhado ao próximo tick.
+ */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+    __asm volatile ("cpsid i" ::: "memory");
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+
+    // Uma task ficou pronta enquanto a idle decidia dormir
+    if (alarm_num < 0 || eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __asm volatile ("cpsie i" ::: "memory");
+        return;
+    }
+
+    // Para o SysTick sem ler o CSR; se o tick já está pendente, o kernel trata e volta aqui
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_TICKINT_BITS;
+    if (scb_hw->icsr & M0PLUS_ICSR_PENDSTSET_BITS) {
+        systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+        __asm volatile ("cpsie i" ::: "memory");
+        return;
+    }
+
+    // Acorda na fronteira do tick em que a próxima task desbloqueia
+    uint64_t start = time_us_64();
+    uint32_t to_tick_us = systick_hw->cvr / cycles_per_us;
+    uint64_t wake = start + to_tick_us + (uint64_t)(xExpectedIdleTime - 1) * TICK_US;
+
+    if (!hardware_alarm_set_target(alarm_num, from_us_since_boot(wake))) {
+        TickType_t idle = xExpectedIdleTime;
+
+        configPRE_SLEEP_PROCESSING(idle);
+        if (idle > 0) {
+            __asm volatile ("dsb" ::: "memory");
+            __asm volatile ("wfi");
+            __asm volatile ("isb");
+        }
+        configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+    }
+
+    // Deixa rodar a interrupção que acordou o núcleo e fecha de novo para a conta
+    __asm volatile ("cpsie i" ::: "memory");
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+    __asm volatile ("cpsid i" ::: "memory");
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+    hardware_alarm_cancel(alarm_num);
+
+    uint64_t elapsed = time_us_64() - start;
+    TickType_t ticks = 0;
+    uint32_t next_tick_us;
+
+    if (elapsed < to_tick_us) {
+        next_tick_us = to_tick_us - (uint32_t)elapsed;
+    } else {
+        uint64_t after = elapsed - to_tick_us;
+        ticks = 1 + after / TICK_US;
+        next_tick_us = TICK_US - (uint32_t)(after % TICK_US);
+        // Acordou depois do previsto (interrupções longas): o excesso vira deriva do relógio
+        if (ticks > xExpectedIdleTime)
+            ticks = xExpectedIdleTime;
+    }
+    if (next_tick_us < TICKLESS_MIN_RELOAD_US)
+        next_tick_us = TICKLESS_MIN_RELOAD_US;
+    slept_us += elapsed;
+
+    // Religa o SysTick com o resto do tick atual; a recarga normal vale a partir do próximo
+    systick_hw->rvr = next_tick_us * cycles_per_us - 1;
+    systick_hw->cvr = 0;
+    systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+    if (ticks > 0)
+        vTaskStepTick(ticks);
+    systick_hw->rvr = cycles_per_tick - 1;
+
+    __asm volatile ("cpsie i" ::: "memory");
+}
+
+#endif
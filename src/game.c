@@ -1,4 +1,5 @@
 #include "game.h"
+#include "game_snapshot.h"
 
 /**
  * @brief Instância global da estrutura de controle do display OLED.
@@ -11,6 +12,15 @@ ssd1306_t oled_display;
 GameState_t g_game_state;
 
 /**
- * @brief Handle para o mutex que protege o acesso à estrutura g_game_state.
+ * @brief Handle do grupo de eventos que acorda a task do display.
  */
-SemaphoreHandle_t g_game_state_mutex;
+EventGroupHandle_t g_game_events;
+
+void game_state_publish(void) {
+    game_snapshot_publish(&g_game_state);
+    game_state_changed();
+}
+
+void game_state_changed(void) {
+    xEventGroupSetBits(g_game_events, GAME_EVENT_STATE_CHANGED);
+}
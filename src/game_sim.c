@@ -0,0 +1,276 @@
+#include "game_sim.h"
+#include "alien_fleet.h"
+#include "bullet_pool.h"
+
+#define STEPS(ms) ((ms) / SIM_STEP_MS)
+
+#define PLAYER_MOVE_STEP 1
+#define PLAYER_SHOT_DEBOUNCE_STEPS STEPS(250)
+#define PLAYER_BULLET_SPEED 2
+#define ENEMY_BULLET_SPEED 2
+#define ALIEN_STEP_X 5
+#define ALIEN_STEP_Y 5
+#define ALIEN_MOVE_SPEED_START 700
+#define ALIEN_MOVE_SPEED_DECREMENT 100
+#define ALIEN_MOVE_SPEED_MIN 100
+#define ENEMY_SHOT_COOLDOWN_STEPS STEPS(100)
+#define CHANCE_OF_ENEMY_SHOT 3
+#define SIM_DEFAULT_SEED 0x2545f491u    // o xorshift nunca sai do zero
+
+// xorshift32: três deslocamentos por número, sem multiplicação nem estado extra
+static uint32_t sim_rand(GameState_t *state) {
+    uint32_t x = state->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return state->rng = x;
+}
+
+const GameLevel_t game_levels[GAME_LEVEL_COUNT] = {
+    [GAME_LEVEL_NORMAL] = {
+        .formation = {.rows = 2, .cols = 10, .spacing_x = ALIEN_WIDTH + 4, .spacing_y = ALIEN_HEIGHT + 4},
+        .fleet_x = 15, .fleet_y = 10,
+        .player_bullets = 1, .enemy_bullets = 4,
+    },
+    // 128 aliens e 64 tiros: a formação aperta o espaçamento para caber na tela
+    [GAME_LEVEL_STRESS] = {
+        .formation = {.rows = 8, .cols = 16, .spacing_x = ALIEN_WIDTH + 2, .spacing_y = ALIEN_HEIGHT - 3},
+        .fleet_x = 9, .fleet_y = 8,
+        .player_bullets = 16, .enemy_bullets = 48,
+    },
+};
+
+void game_sim_seed(GameState_t *state, uint32_t seed) {
+    state->rng = seed ? seed : SIM_DEFAULT_SEED;
+}
+
+void game_sim_reset(GameState_t *state) {
+    const GameLevel_t *level = &game_levels[state->level < GAME_LEVEL_COUNT ? state->level : GAME_LEVEL_NORMAL];
+
+    state->player_obj.x = OLED_WIDTH / 2 - PLAYER_WIDTH / 2;
+    state->player_obj.y = PLAYER_Y_POS;
+    state->player_obj.active = true;
+    bullet_pool_init(&state->bullets, level->player_bullets);
+    bullet_pool_init(&state->enemy_bullets, level->enemy_bullets);
+    alien_fleet_init(&state->fleet, &level->formation, level->fleet_x, level->fleet_y);
+    state->alien_dx = 1;
+    state->alien_move_down_next = false;
+    state->last_alien_move_step = state->step;
+    // Tiros liberados já no primeiro passo, sem depender da partida anterior
+    state->last_player_shot_step = state->step - PLAYER_SHOT_DEBOUNCE_STEPS - 1;
+    state->last_enemy_shot_step = state->step - ENEMY_SHOT_COOLDOWN_STEPS - 1;
+    state->current_alien_move_speed_ms = ALIEN_MOVE_SPEED_START;
+    state->score = 0;
+    state->lives = 3;
+}
+
+// Entrada: troca de tela pelo botão e, jogando, movimento e disparo
+static uint32_t step_input(GameState_t *state, const GameInput_t *input) {
+    bool pressed = input->fire && !state->fire_held;
+    uint32_t events = 0;
+
+    state->fire_held = input->fire;
+
+    switch (state->current_game_internal_state) {
+        case GAME_START_SCREEN:
+            if (pressed) {
+                state->current_game_internal_state = GAME_PLAYING;
+                game_sim_reset(state);
+                events = SIM_EVENT_CHANGED | SIM_EVENT_GAME_START;
+            }
+            break;
+
+        case GAME_PLAYING: {
+            int prev_x = state->player_obj.x;
+
+            state->player_obj.x += input->move * PLAYER_MOVE_STEP;
+            if (state->player_obj.x < 0)
+                state->player_obj.x = 0;
+            if (state->player_obj.x > OLED_WIDTH - PLAYER_WIDTH)
+                state->player_obj.x = OLED_WIDTH - PLAYER_WIDTH;
+            if (state->player_obj.x != prev_x)
+                events = SIM_EVENT_CHANGED;
+
+            if (pressed && state->step - state->last_player_shot_step > PLAYER_SHOT_DEBOUNCE_STEPS) {
+                state->last_player_shot_step = state->step;
+
+                if (bullet_pool_spawn(&state->bullets, state->player_obj.x + (PLAYER_WIDTH / 2), PLAYER_Y_POS - 1))
+                    events = SIM_EVENT_CHANGED | SIM_EVENT_PLAYER_SHOOT;
+            }
+            break;
+        }
+
+        case GAME_OVER:
+        case GAME_WIN:
+            if (pressed) {
+                state->current_game_internal_state = GAME_START_SCREEN;
+                events = SIM_EVENT_CHANGED;
+            }
+            break;
+    }
+    return events;
+}
+
+// Tiros: só o movimento; os acertos ficam para a etapa de colisões.
+// Os laços que removem andam de trás para frente (ver bullet_pool_despawn)
+static bool step_bullets(GameState_t *state) {
+    BulletPool *bullets = &state->bullets;
+    BulletPool *enemy_bullets = &state->enemy_bullets;
+    bool changed = bullets->count > 0 || enemy_bullets->count > 0;
+
+    for (int i = bullets->count - 1; i >= 0; --i) {
+        bullets->items[i].y -= PLAYER_BULLET_SPEED;
+        if (bullets->items[i].y < 0)
+            bullet_pool_despawn(bullets, i);
+    }
+
+    for (int i = enemy_bullets->count - 1; i >= 0; --i) {
+        enemy_bullets->items[i].y += ENEMY_BULLET_SPEED;
+        if (enemy_bullets->items[i].y > OLED_HEIGHT)
+            bullet_pool_despawn(enemy_bullets, i);
+    }
+    return changed;
+}
+
+// Disparo dos aliens: cada coluna com alguém vivo pode atirar pelo alien mais de baixo
+static void alien_shoot(GameState_t *state) {
+    const AlienFleet *fleet = &state->fleet;
+
+    for (uint32_t cols = fleet->columns; cols; cols &= cols - 1) {
+        int c = __builtin_ctz(cols);
+        int r = alien_fleet_shooter_row(fleet, c);
+
+        if ((sim_rand(state) % CHANCE_OF_ENEMY_SHOT) == 0)
+            bullet_pool_spawn(&state->enemy_bullets, alien_fleet_slot_x(fleet, c) + (ALIEN_WIDTH / 2),
+                              alien_fleet_slot_y(fleet, r) + ALIEN_HEIGHT);
+    }
+}
+
+// Frota: anda de lado até a borda, desce um passo e acelera
+static bool step_aliens(GameState_t *state) {
+    if ((state->step - state->last_alien_move_step) * SIM_STEP_MS <= state->current_alien_move_speed_ms)
+        return false;
+    state->last_alien_move_step = state->step;
+
+    AlienFleet *fleet = &state->fleet;
+
+    if (state->alien_move_down_next) {
+        alien_fleet_move(fleet, 0, ALIEN_STEP_Y);
+
+        state->alien_dx *= -1;
+
+        if (state->current_alien_move_speed_ms > ALIEN_MOVE_SPEED_MIN) {
+            state->current_alien_move_speed_ms -= ALIEN_MOVE_SPEED_DECREMENT;
+            if (state->current_alien_move_speed_ms < ALIEN_MOVE_SPEED_MIN)
+                state->current_alien_move_speed_ms = ALIEN_MOVE_SPEED_MIN;
+        }
+        state->alien_move_down_next = false;
+    } else if (fleet->count > 0) {
+        alien_fleet_move(fleet, state->alien_dx * ALIEN_STEP_X, 0);
+
+        if ((state->alien_dx < 0 && alien_fleet_left(fleet) <= 0) ||
+            (state->alien_dx > 0 && alien_fleet_right(fleet) >= OLED_WIDTH))
+            state->alien_move_down_next = true;
+    }
+
+    if (state->step - state->last_enemy_shot_step > ENEMY_SHOT_COOLDOWN_STEPS) {
+        state->last_enemy_shot_step = state->step;
+        alien_shoot(state);
+    }
+    return true;
+}
+
+static bool hits(const GameObject *o, int x, int y, int width, int height) {
+    return o->x >= x && o->x < x + width && o->y >= y && o->y < y + height;
+}
+
+// Colisões: tiros do jogador contra a frota, tiros dos aliens contra o jogador
+static uint32_t step_collisions(GameState_t *state) {
+    uint32_t events = 0;
+
+    BulletPool *bullets = &state->bullets;
+    BulletPool *enemy_bullets = &state->enemy_bullets;
+
+    for (int i = bullets->count - 1; i >= 0; --i) {
+        if (alien_fleet_hit(&state->fleet, bullets->items[i].x, bullets->items[i].y)) {
+            bullet_pool_despawn(bullets, i);
+            state->score += 10;
+            events |= SIM_EVENT_ALIEN_HIT;
+        }
+    }
+
+    if (!state->player_obj.active)
+        return events;
+
+    for (int i = enemy_bullets->count - 1; i >= 0; --i) {
+        if (hits(&enemy_bullets->items[i], state->player_obj.x, state->player_obj.y, PLAYER_WIDTH, PLAYER_HEIGHT)) {
+            bullet_pool_despawn(enemy_bullets, i);
+            state->lives--;
+            events |= SIM_EVENT_PLAYER_HIT;
+        }
+    }
+    return events;
+}
+
+// Fim de partida: sem vidas ou frota no chão perde, frota destruída vence
+static uint32_t step_outcome(GameState_t *state) {
+    const AlienFleet *fleet = &state->fleet;
+    bool landed = fleet->count > 0 && alien_fleet_bottom(fleet) >= state->player_obj.y;
+
+    if (state->lives <= 0 || landed) {
+        state->current_game_internal_state = GAME_OVER;
+        return SIM_EVENT_GAME_OVER;
+    }
+    if (fleet->count == 0) {
+        state->current_game_internal_state = GAME_WIN;
+        return SIM_EVENT_GAME_WIN;
+    }
+    return 0;
+}
+
+uint32_t game_sim_step(GameState_t *state, const GameInput_t *input) {
+    uint32_t step = ++state->step;
+    uint32_t events = 0;
+    bool moved = false;
+
+    if (step % SIM_PLAYER_DIVISOR == 0)
+        events |= step_input(state, input);
+
+    if (state->current_game_internal_state != GAME_PLAYING)
+        return events;
+
+    if (step % SIM_BULLET_DIVISOR == 0)
+        moved |= step_bullets(state);
+    if (step % SIM_ALIEN_DIVISOR == 0)
+        moved |= step_aliens(state);
+
+    // Colisões e fim de partida só mudam quando algo se moveu ou o jogador agiu
+    if (moved || events) {
+        events |= SIM_EVENT_CHANGED;
+        events |= step_collisions(state);
+        events |= step_outcome(state);
+    }
+    return events;
+}
+
+uint32_t game_sim_steps_due(GameState_t *state, uint32_t dt_ms) {
+    uint32_t steps;
+
+    state->step_accum_ms += dt_ms;
+    steps = state->step_accum_ms / SIM_STEP_MS;
+    if (steps > SIM_MAX_CATCHUP_STEPS) {
+        steps = SIM_MAX_CATCHUP_STEPS;
+        state->step_accum_ms %= SIM_STEP_MS;
+    } else {
+        state->step_accum_ms -= steps * SIM_STEP_MS;
+    }
+    return steps;
+}
+
+uint32_t game_step(GameState_t *state, const GameInput_t *input, uint32_t dt_ms) {
+    uint32_t events = 0;
+
+    for (uint32_t steps = game_sim_steps_due(state, dt_ms); steps > 0; --steps)
+        events |= game_sim_step(state, input);
+    return events;
+}
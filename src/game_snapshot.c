@@ -0,0 +1,29 @@
+#include <string.h>
+#include <stdatomic.h>
+#include "game_snapshot.h"
+
+static GameState_t snapshots[2];
+static atomic_uint_least32_t sequence;  // cópia publicada: snapshots[sequence & 1]
+
+void game_snapshot_publish(const GameState_t *state) {
+    uint32_t seq = atomic_load_explicit(&sequence, memory_order_relaxed);
+
+    // Escreve na cópia que nenhum leitor deveria estar usando e só depois a publica
+    memcpy(&snapshots[(seq + 1) & 1], state, sizeof(*state));
+    atomic_store_explicit(&sequence, seq + 1, memory_order_release);
+}
+
+uint32_t game_snapshot_read(GameState_t *out) {
+    uint32_t seq, check;
+
+    do {
+        seq = atomic_load_explicit(&sequence, memory_order_acquire);
+        memcpy(out, &snapshots[seq & 1], sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        // Outra publicação terminou no meio da cópia: a próxima já pode estar
+        // sobrescrevendo esta cópia, então lê de novo
+        check = atomic_load_explicit(&sequence, memory_order_relaxed);
+    } while (check != seq);
+
+    return seq;
+}
@@ -0,0 +1,105 @@
+#include <string.h>
+#include "hud.h"
+
+uint8_t hud_format_uint(char *dst, uint32_t value) {
+    char tmp[HUD_MAX_DIGITS];
+    uint8_t count = 0;
+
+    // Do menos para o mais significativo, depois inverte
+    do {
+        tmp[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    for (uint8_t i = 0; i < count; ++i)
+        dst[i] = tmp[count - 1 - i];
+    return count;
+}
+
+// Copia as colunas do glifo para o campo a partir de x; retorna a largura
+static uint8_t put_glyph(HudField *field, uint32_t x, char c) {
+    const ssd1306_font_t *font = field->font;
+    const uint8_t ch = (uint8_t)c;
+
+    if (ch < font->first || ch > font->last)
+        return 0;
+
+    const uint8_t width = font->widths[ch - font->first];
+    const uint8_t *cols = font->data + font->offsets[ch - font->first];
+
+    for (uint8_t i = 0; i < width && x + i < HUD_FIELD_MAX_WIDTH; ++i)
+        field->data[x + i] = cols[i * font->pages];
+    return width;
+}
+
+// Redesenha uma célula: apaga e centraliza o dígito nela
+static void put_digit(HudField *field, uint8_t cell, char digit) {
+    const uint32_t x = field->digits_x + cell * field->cell_width;
+    const ssd1306_font_t *font = field->font;
+
+    memset(field->data + x, 0, field->cell_width);
+    if (digit != ' ') {
+        const uint8_t width = font->widths[(uint8_t)digit - font->first];
+        put_glyph(field, x + (field->cell_width - font->spacing - width) / 2, digit);
+    }
+    field->shown[cell] = digit;
+}
+
+void hud_field_init(HudField *field, const ssd1306_font_t *font, const char *label, uint8_t digits) {
+    uint8_t cell_width = 0;
+
+    memset(field->data, 0, sizeof(field->data));
+    field->font = font;
+
+    // Células com a largura do dígito mais largo, para os números não dançarem
+    for (char d = '0'; d <= '9'; ++d)
+        if (font->widths[d - font->first] > cell_width)
+            cell_width = font->widths[d - font->first];
+    field->cell_width = cell_width + font->spacing;
+
+    uint32_t x = 0;
+    for (; *label && x < HUD_FIELD_MAX_WIDTH; ++label)
+        x += put_glyph(field, x, *label) + font->spacing;
+
+    if (digits > HUD_MAX_DIGITS)
+        digits = HUD_MAX_DIGITS;
+    while (digits && x + digits * field->cell_width > HUD_FIELD_MAX_WIDTH)
+        --digits;
+
+    field->digits_x = x;
+    field->digits = digits;
+    memset(field->shown, ' ', sizeof(field->shown));
+
+    field->image.width = x + digits * field->cell_width - font->spacing;
+    field->image.height = font->height;
+    field->image.data = field->data;
+
+    // Valor impossível de ter sido desenhado, para o 0 inicial aparecer
+    field->value = UINT32_MAX;
+    hud_field_set(field, 0);
+}
+
+bool hud_field_set(HudField *field, uint32_t value) {
+    char text[HUD_MAX_DIGITS];
+    bool changed = false;
+
+    if (value == field->value)
+        return false;
+    field->value = value;
+
+    uint8_t count = hud_format_uint(text, value);
+    if (count > field->digits) {
+        count = field->digits;
+        memset(text, '9', count);
+    }
+
+    // Alinhado à esquerda: as células depois do número ficam vazias
+    for (uint8_t cell = 0; cell < field->digits; ++cell) {
+        const char digit = cell < count ? text[cell] : ' ';
+        if (field->shown[cell] != digit) {
+            put_digit(field, cell, digit);
+            changed = true;
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,107 @@
+#include <string.h>
+#include "input_log.h"
+
+static const uint8_t input_log_magic[4] = {'I', 'N', 'P', '1'};
+
+static void put_u32(uint8_t *dst, uint32_t val) {
+    for (int i = 0; i < 4; ++i)
+        dst[i] = (uint8_t)(val >> (8 * i));
+}
+
+static uint32_t get_u32(const uint8_t *src) {
+    return src[0] | (uint32_t)src[1] << 8 | (uint32_t)src[2] << 16 | (uint32_t)src[3] << 24;
+}
+
+static uint8_t encode_input(const GameInput_t *input) {
+    return (uint8_t)((input->move + 1) | (input->fire ? 1 << 2 : 0));
+}
+
+void input_log_init(InputLog *log, uint8_t *buf, size_t size) {
+    memset(log, 0, sizeof(*log));
+    log->buf = buf;
+    log->size = size;
+}
+
+void input_log_arm(InputLog *log, const GameState_t *state) {
+    memcpy(log->armed, input_log_magic, sizeof(input_log_magic));
+    put_u32(log->armed + 4, state->step);
+    put_u32(log->armed + 8, state->rng);
+    log->armed[12] = state->fire_held;
+    log->armed[13] = state->level;
+    log->armed[14] = log->armed[15] = 0;
+}
+
+void input_log_begin(InputLog *log) {
+    if (log->frozen || log->size < INPUT_LOG_HEADER_SIZE)
+        return;
+    memcpy(log->buf, log->armed, INPUT_LOG_HEADER_SIZE);
+    log->len = INPUT_LOG_HEADER_SIZE;
+    log->full = false;
+}
+
+void input_log_record(InputLog *log, const GameInput_t *input, uint32_t steps) {
+    // Um buraco no meio tornaria o resto irreproduzível: exportar encerra a gravação
+    if (log->frozen)
+        log->full = true;
+    if (log->len == 0 || log->full)
+        return;
+
+    uint8_t code = encode_input(input);
+
+    while (steps > 0) {
+        uint8_t *last = log->len > INPUT_LOG_HEADER_SIZE ? &log->buf[log->len - 1] : NULL;
+
+        // Mesma entrada do byte anterior: só aumenta a sequência
+        if (last && (*last & 0x07) == code && (*last >> 3) < INPUT_LOG_MAX_RUN - 1) {
+            uint32_t room = INPUT_LOG_MAX_RUN - 1 - (*last >> 3);
+            uint32_t n = steps < room ? steps : room;
+            *last += (uint8_t)(n << 3);
+            steps -= n;
+            continue;
+        }
+
+        if (log->len == log->size) {
+            log->full = true;
+            return;
+        }
+        log->buf[log->len++] = code;
+        steps--;
+    }
+}
+
+bool input_replay_open(InputReplay *replay, const uint8_t *data, size_t len, GameState_t *state) {
+    if (len < INPUT_LOG_HEADER_SIZE || memcmp(data, input_log_magic, sizeof(input_log_magic)) != 0 ||
+        data[13] >= GAME_LEVEL_COUNT)
+        return false;
+
+    memset(replay, 0, sizeof(*replay));
+    replay->data = data;
+    replay->len = len;
+    replay->pos = INPUT_LOG_HEADER_SIZE;
+
+    // Tela inicial: o resto do estado é refeito quando a partida começa
+    memset(state, 0, sizeof(*state));
+    state->current_game_internal_state = GAME_START_SCREEN;
+    state->step = get_u32(data + 4);
+    game_sim_seed(state, get_u32(data + 8));
+    state->fire_held = data[12] != 0;
+    state->level = data[13];
+    game_sim_reset(state);
+    return true;
+}
+
+bool input_replay_next(InputReplay *replay, GameInput_t *input) {
+    if (replay->run == 0) {
+        if (replay->pos == replay->len)
+            return false;
+
+        uint8_t b = replay->data[replay->pos++];
+        replay->input.move = (int8_t)((b & 0x03) - 1);
+        replay->input.fire = (b & 0x04) != 0;
+        replay->run = (b >> 3) + 1;
+    }
+
+    replay->run--;
+    *input = replay->input;
+    return true;
+}
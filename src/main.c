@@ -1,24 +1,43 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
+#include "pico/rand.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "game.h"
+#include "game_sim.h"
 #include "buzzer.h"
 #include "rgb.h"
 #include "pause.h"
 #include "effects_task.h"
+#include "tickless_idle.h"
+
+#ifndef GAME_START_LEVEL
+#define GAME_START_LEVEL GAME_LEVEL_NORMAL
+#endif
 
 // Protótipos de funções de inicialização e tasks
 void init_joystick_and_buttons(void);
 void init_oled(void);
 void init_buzzer_rgb(void);
 void oled_display_task(void *);
-void player_control_task(void *);
-void bullet_logic_task(void *);
-void alien_logic_task(void *);
+void game_sim_task(void *);
 void game_status_task(void *);
 void pause_task(void *);
 
+/**
+ * @brief Chamado pelo kernel quando uma task estoura a pilha (configCHECK_FOR_STACK_OVERFLOW).
+ *
+ * A pilha da task já está corrompida: só acende o LED vermelho e para tudo,
+ * para o estouro não virar um defeito aleatório em outra task.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    (void)task;
+    (void)name;
+    taskDISABLE_INTERRUPTS();
+    led_set_color(RED);
+    while (1);
+}
+
 /**
  * @brief Função principal do programa.
  */
@@ -33,30 +52,33 @@ int main() {
     init_buzzer_rgb();
     effects_init();
 
-    // Cria o mutex para proteger o estado do jogo
-    g_game_state_mutex = xSemaphoreCreateMutex();
-    if (g_game_state_mutex == NULL)
-        while (1); // Falha ao criar o mutex
+    // Cria o grupo de eventos que acorda o display quando o estado muda
+    g_game_events = xEventGroupCreate();
+    if (g_game_events == NULL)
+        while (1); // Falha ao criar o grupo de eventos
 
-    // Define o estado inicial do jogo de forma segura
-    if (xSemaphoreTake(g_game_state_mutex, portMAX_DELAY)) {
-        g_game_state.current_game_internal_state = GAME_START_SCREEN;
-        initialize_game_data_unsafe();
-        xSemaphoreGive(g_game_state_mutex);
-    }
+    // Define o estado inicial do jogo, antes de a task de simulação existir
+    g_game_state.current_game_internal_state = GAME_START_SCREEN;
+    g_game_state.level = GAME_START_LEVEL;
+    game_sim_seed(&g_game_state, get_rand_32());
+    game_sim_reset(&g_game_state);
+    game_state_publish();   // Desenha a tela inicial
     
     // Define uma cor inicial para o LED
     led_set_color(PURPLE);
 
     // Cria as tasks do FreeRTOS
     xTaskCreate(oled_display_task, "OLED", 512, NULL, 2, NULL);
-    xTaskCreate(player_control_task, "Player", 256, NULL, 3, NULL);
-    xTaskCreate(bullet_logic_task, "Bullets", 256, NULL, 2, NULL);
-    xTaskCreate(alien_logic_task, "Aliens", 256, NULL, 2, NULL);
-    xTaskCreate(game_status_task, "Status", 128, NULL, 1, NULL);
+    xTaskCreate(game_sim_task, "Sim", 256, NULL, 3, NULL);
+    xTaskCreate(game_status_task, "Status", 512, NULL, 1, NULL);   // printf usa boa parte da pilha
     xTaskCreate(pause_task, "Pause", 128, NULL, 3, NULL);
     xTaskCreate(effects_task, "Effects", 512, NULL, 3, NULL);
 
+#if configUSE_TICKLESS_IDLE == 1
+    // Sem tasks prontas, o núcleo dorme em WFI até o próximo evento (idle sem tick)
+    tickless_idle_init();
+#endif
+
     // Inicia o escalonador do FreeRTOS
     vTaskStartScheduler();
 
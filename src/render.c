@@ -0,0 +1,191 @@
+#include <string.h>
+#include "render.h"
+#include "display_list.h"
+#include "hud.h"
+#include "screen_fx.h"
+#include "alien_fleet.h"
+
+// Sprites gerados em tempo de compilação a partir de assets/*.pbm
+#include "asset_player.h"
+#include "asset_alien.h"
+#include "asset_bullet.h"
+#include "font_small.h"
+#include "font_large.h"
+#include "asset_starfield.h"
+
+// Uma tela de jogo no maior nível: HUD, jogador, tiros e frota
+_Static_assert(DISPLAY_LIST_MAX_NODES >= 3 + 2 * BULLET_POOL_MAX + ALIEN_MAX_ROWS * ALIEN_MAX_COLS,
+               "a lista de objetos não cabe a tela de jogo");
+
+static DisplayList scene;
+static int shown_screen = -1;   // tela montada na lista, -1 força a remontagem
+static int shown_level = -1;    // nível da tela montada: a frota e os pools mudam com ele
+
+static int player_node;
+static int bullet_nodes[BULLET_POOL_MAX];
+static int enemy_bullet_nodes[BULLET_POOL_MAX];
+static int alien_nodes[ALIEN_MAX_ROWS][ALIEN_MAX_COLS];
+static int score_node;
+static int lives_node;
+static int final_node;          // pontuação final nas telas de fim de jogo
+
+// O que os nós mostram hoje: só o que mudou desde então é atualizado
+static uint8_t shown_bullets;
+static uint8_t shown_enemy_bullets;
+static int shown_fleet_x, shown_fleet_y;
+static uint32_t shown_alive[ALIEN_MAX_ROWS];
+
+// HUD pré-renderizado: só os dígitos que mudam são redesenhados
+static HudField score_field;
+static HudField lives_field;
+
+// Posição x que centraliza o texto na tela
+static int16_t centered_x(const ssd1306_font_t *font, const char *text) {
+    uint32_t width = ssd1306_text_width(font, text);
+    return width < OLED_WIDTH ? (OLED_WIDTH - width) / 2 : 0;
+}
+
+static void add_centered(int16_t y, const ssd1306_font_t *font, const char *text) {
+    display_list_add_text(&scene, font, centered_x(font, text), y, text);
+}
+
+// Um nó por vaga do pool (capacidade do nível), visíveis só os tiros ativos
+static void add_bullets(int *nodes, const BulletPool *pool) {
+    for (int i = 0; i < pool->capacity; ++i)
+        nodes[i] = display_list_add_sprite(&scene, &asset_bullet, 0, 0, false);
+    for (int i = 0; i < pool->count; ++i)
+        display_list_set(&scene, nodes[i], pool->items[i].x, pool->items[i].y, true);
+}
+
+// Monta a lista de objetos da tela atual; chamada só na troca de tela
+static void build_scene(const GameState_t *state) {
+    display_list_reset(&scene);
+
+    switch (state->current_game_internal_state) {
+
+        case GAME_START_SCREEN:
+            add_centered(4, &font_small, "BitDog");
+            add_centered(16, &font_large, "INVADERS");
+            add_centered(34, &font_small, "Pressione B");
+            // Rolado pelo scroll do display, sem redesenho
+            display_list_add_image(&scene, &asset_starfield, 0, SCREEN_FX_STARFIELD_Y);
+            break;
+
+        case GAME_PLAYING:
+            // Opacos, então vêm antes dos sprites que podem passar por cima
+            hud_field_init(&score_field, &font_small, "Score: ", 5);
+            hud_field_init(&lives_field, &font_small, "Vidas: ", 1);
+            score_node = display_list_add_image(&scene, &score_field.image, 0, 0);
+            lives_node = display_list_add_image(&scene, &lives_field.image,
+                                                OLED_WIDTH - lives_field.image.width, 0);
+
+            player_node = display_list_add_sprite(&scene, &asset_player, state->player_obj.x, PLAYER_Y_POS,
+                                                  state->player_obj.active);
+
+            add_bullets(bullet_nodes, &state->bullets);
+            add_bullets(enemy_bullet_nodes, &state->enemy_bullets);
+            shown_bullets = state->bullets.count;
+            shown_enemy_bullets = state->enemy_bullets.count;
+
+            for (int r = 0; r < state->fleet.formation.rows; ++r) {
+                for (int c = 0; c < state->fleet.formation.cols; ++c)
+                    alien_nodes[r][c] = display_list_add_sprite(&scene, &asset_alien,
+                                                                alien_fleet_slot_x(&state->fleet, c),
+                                                                alien_fleet_slot_y(&state->fleet, r),
+                                                                alien_fleet_alive(&state->fleet, r, c));
+                shown_alive[r] = state->fleet.alive[r];
+            }
+            shown_fleet_x = state->fleet.x;
+            shown_fleet_y = state->fleet.y;
+            break;
+
+        case GAME_OVER:
+            add_centered(14, &font_large, "GAME OVER");
+            final_node = display_list_add_text(&scene, &font_small, 0, 40, "");
+            break;
+
+        case GAME_WIN:
+            add_centered(4, &font_large, "VOCE");
+            add_centered(22, &font_large, "VENCEU!");
+            final_node = display_list_add_text(&scene, &font_small, 0, 46, "");
+            break;
+
+        default:
+            add_centered(28, &font_small, "Estado Desconhecido");
+            break;
+    }
+}
+
+// Tiros ativos nos primeiros nós; os que sobraram do quadro anterior somem
+static uint8_t update_bullets(const int *nodes, const BulletPool *pool, uint8_t shown) {
+    for (int i = 0; i < pool->count; ++i)
+        display_list_set(&scene, nodes[i], pool->items[i].x, pool->items[i].y, true);
+    for (int i = pool->count; i < shown; ++i)
+        display_list_hide(&scene, nodes[i]);
+    return pool->count;
+}
+
+// Aliens mortos desde o último quadro somem; os vivos só são mexidos quando a frota anda
+static void update_fleet(const AlienFleet *fleet) {
+    bool moved = fleet->x != shown_fleet_x || fleet->y != shown_fleet_y;
+
+    for (int r = 0; r < fleet->formation.rows; ++r) {
+        for (uint32_t gone = shown_alive[r] & ~fleet->alive[r]; gone; gone &= gone - 1)
+            display_list_hide(&scene, alien_nodes[r][__builtin_ctz(gone)]);
+
+        for (uint32_t alive = moved ? fleet->alive[r] : 0; alive; alive &= alive - 1) {
+            int c = __builtin_ctz(alive);
+            display_list_set(&scene, alien_nodes[r][c], alien_fleet_slot_x(fleet, c), alien_fleet_slot_y(fleet, r), true);
+        }
+        shown_alive[r] = fleet->alive[r];
+    }
+    shown_fleet_x = fleet->x;
+    shown_fleet_y = fleet->y;
+}
+
+// Copia o estado do jogo para os nós; os que não mudaram não são redesenhados
+static void update_playing(const GameState_t *state) {
+    display_list_set(&scene, player_node, state->player_obj.x, PLAYER_Y_POS, state->player_obj.active);
+
+    shown_bullets = update_bullets(bullet_nodes, &state->bullets, shown_bullets);
+    shown_enemy_bullets = update_bullets(enemy_bullet_nodes, &state->enemy_bullets, shown_enemy_bullets);
+    update_fleet(&state->fleet);
+
+    if (hud_field_set(&score_field, state->score > 0 ? state->score : 0))
+        display_list_touch(&scene, score_node);
+    if (hud_field_set(&lives_field, state->lives > 0 ? state->lives : 0))
+        display_list_touch(&scene, lives_node);
+}
+
+// Pontuação final centralizada
+static void update_final(const GameState_t *state) {
+    static const char label[] = "Final: ";
+    char text[sizeof(label) + HUD_MAX_DIGITS];
+
+    uint8_t len = sizeof(label) - 1;
+
+    memcpy(text, label, len);
+    len += hud_format_uint(text + len, state->score > 0 ? state->score : 0);
+    text[len] = '\0';
+    display_list_set_text(&scene, final_node, text);
+    display_list_set(&scene, final_node, centered_x(&font_small, text), scene.nodes[final_node].y, true);
+}
+
+bool render_frame(ssd1306_t *oled, const GameState_t *state) {
+    if ((int)state->current_game_internal_state != shown_screen || state->level != shown_level) {
+        build_scene(state);
+        shown_screen = state->current_game_internal_state;
+        shown_level = state->level;
+    }
+
+    if (state->current_game_internal_state == GAME_PLAYING)
+        update_playing(state);
+    else if (state->current_game_internal_state == GAME_OVER || state->current_game_internal_state == GAME_WIN)
+        update_final(state);
+
+    return display_list_render(&scene, oled) > 0;
+}
+
+void render_invalidate(void) {
+    shown_screen = -1;
+}
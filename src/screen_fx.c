@@ -0,0 +1,70 @@
+#include "screen_fx.h"
+
+#define TRANSITION_FRAMES 6     // quadros da nova tela rolando até o lugar
+
+typedef enum {
+    FX_NONE,
+    FX_TRANSITION,              // troca de tela
+    FX_SHAKE                    // jogador atingido
+} ScreenFxKind_e;
+
+#define RAM_ROWS (SSD1306_RAM_PAGES * 8)    // a RAM do controlador tem 64 linhas em qualquer painel
+
+// Linhas iniciais da tremida: desce, sobe e volta. A linha inicial dá a volta
+// no fim da RAM, não do painel: subir 3 é RAM_ROWS - 3. Nos painéis mais
+// baixos as linhas de RAM abaixo do painel, que aparecem nos efeitos, foram
+// zeradas em ssd1306_init_with_transport
+static const uint8_t shake_lines[] = {3, RAM_ROWS - 3, 2, RAM_ROWS - 2, 1, 0};
+
+static ScreenFxKind_e active = FX_NONE;
+static uint8_t step;
+static int shown_screen = -1;   // -1: nenhuma tela mostrada ainda
+static int shown_lives;
+static bool starfield_on;
+
+bool screen_fx_update(ssd1306_t *oled, GameInternalState_e screen, int lives) {
+    bool screen_changed = (int)screen != shown_screen;
+
+    if (screen_changed) {
+        // O scroll moveu a RAM do display: para antes do envio da nova tela,
+        // que então vai inteira
+        ssd1306_scroll_stop(oled);
+        starfield_on = false;
+
+        active = shown_screen < 0 ? FX_NONE : FX_TRANSITION;
+        step = 0;
+        shown_screen = screen;
+    } else if (screen == GAME_PLAYING && lives < shown_lives && active == FX_NONE) {
+        active = FX_SHAKE;
+        step = 0;
+    }
+    shown_lives = lives;
+
+    switch (active) {
+        case FX_TRANSITION:
+            // A nova tela entra rolada meia altura e volta à linha 0 (nos
+            // painéis mais baixos, com a parte de baixo apagada)
+            ssd1306_set_start_line(oled, (TRANSITION_FRAMES - step) * (SSD1306_HEIGHT / 2) / TRANSITION_FRAMES);
+            if (step++ == TRANSITION_FRAMES)
+                active = FX_NONE;
+            break;
+
+        case FX_SHAKE:
+            ssd1306_set_start_line(oled, shake_lines[step]);
+            if (++step == sizeof(shake_lines))
+                active = FX_NONE;
+            break;
+
+        case FX_NONE:
+            break;
+    }
+
+    // Estrelas só com a tela inicial já enviada: dados escritos durante o scroll sairiam embaralhados
+    if (screen == GAME_START_SCREEN && active == FX_NONE && !starfield_on && !screen_changed) {
+        ssd1306_scroll_start(oled, SSD1306_SCROLL_LEFT, SSD1306_PAGES - SCREEN_FX_STARFIELD_PAGES,
+                             SSD1306_PAGES - 1, SSD1306_SCROLL_5_FRAMES);
+        starfield_on = true;
+    }
+
+    return active != FX_NONE || (screen == GAME_START_SCREEN && !starfield_on);
+}
@@ -1,32 +1,89 @@
 #include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "game.h"
+#include "tickless_idle.h"
 
-// Esta função é o seu initialize_game_data_unsafe() adaptado
-void initialize_game_data_unsafe() {
-    g_game_state.player_obj.x = OLED_WIDTH / 2 - PLAYER_WIDTH / 2;
-    g_game_state.player_obj.y = PLAYER_Y_POS;
-    g_game_state.player_obj.active = true;
-    for (int i = 0; i < MAX_PLAYER_BULLETS; ++i)
-        g_game_state.bullets[i].active = false;
-    for (int i = 0; i < MAX_ENEMY_BULLETS; ++i)
-        g_game_state.enemy_bullets[i].active = false;
-    for (int r = 0; r < NUM_ALIEN_ROWS; ++r)
-        for (int c = 0; c < NUM_ALIEN_COLS; ++c) {
-            g_game_state.aliens[r][c].x = c * (ALIEN_WIDTH + 4) + 15;
-            g_game_state.aliens[r][c].y = r * (ALIEN_HEIGHT + 4) + 10;
-            g_game_state.aliens[r][c].active = true;
-        }
-    g_game_state.alien_dx = 1;
-    g_game_state.last_alien_move_time = xTaskGetTickCount();
-    g_game_state.current_alien_move_speed_ms = 700;
-    g_game_state.score = 0;
-    g_game_state.lives = 3;
+#define DISPLAY_STATS_INTERVAL_MS 5000
+
+static TaskHandle_t status_task_handle;
+
+// Chegou caractere na USB/UART (chamado em interrupção pelo stdio)
+static void chars_available(void *param) {
+    BaseType_t woken = pdFALSE;
+
+    (void)param;
+    vTaskNotifyGiveFromISR(status_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
 }
 
-// Esta função é responsável pela tarefa de status do jogo
+// Esta função é responsável pela tarefa de status do jogo: dorme até chegar
+// um comando pela USB/UART ou até a hora dos relatórios
 void game_status_task(void *pvParameters) {
-    while (1)
-        vTaskDelay(pdMS_TO_TICKS(500));
+    ssd1306_stats_t prev = {0}, curr;
+    ssd1306_i2c_errors_t prev_err = {0}, err;
+    TickType_t next_report = xTaskGetTickCount() + pdMS_TO_TICKS(DISPLAY_STATS_INTERVAL_MS);
+#if configUSE_TICKLESS_IDLE == 1
+    uint64_t prev_us = time_us_64(), prev_slept = tickless_idle_slept_us();
+#endif
+    int c;
+
+    status_task_handle = xTaskGetCurrentTaskHandle();
+    stdio_set_chars_available_callback(chars_available, NULL);
+
+    while (1) {
+        TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(next_report - now) > 0)
+            ulTaskNotifyTake(pdTRUE, next_report - now);
+
+        // Comandos pela USB/UART: 'd' exporta as entradas gravadas, 'r' repete a partida
+        while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+            switch (c) {
+                case 'd':
+                    sim_input_log_export();
+                    break;
+                case 'r':
+                    sim_replay_request();
+                    break;
+            }
+        }
+
+        if ((int32_t)(next_report - xTaskGetTickCount()) > 0)
+            continue;
+        next_report += pdMS_TO_TICKS(DISPLAY_STATS_INTERVAL_MS);
+
+        // Erros do barramento do display: o driver só conta, o aviso sai daqui,
+        // longe do envio dos quadros (printf na UART/USB bloqueia por milissegundos)
+        if (oled_display.transport == &ssd1306_i2c_transport) {
+            ssd1306_i2c_get_errors(&oled_display, &err);
+            if (memcmp(&err, &prev_err, sizeof(err)) != 0)
+                printf("[OLED] erros I2C: nack %lu, timeout %lu, abort %lu, recuperacoes %lu\n",
+                       (unsigned long)err.nacks, (unsigned long)err.timeouts,
+                       (unsigned long)err.aborts, (unsigned long)err.recoveries);
+            prev_err = err;
+        }
+
+        // Relatório de bytes enviados ao display por quadro
+        ssd1306_get_stats(&oled_display, &curr);
+        uint32_t frames = curr.frames - prev.frames;
+        if (frames > 0)
+            printf("[OLED] quadros: %lu, bytes/quadro: %lu, barramento: %lu us/quadro, ultimo: %lu bytes em %lu janelas\n",
+                   (unsigned long)frames,
+                   (unsigned long)((curr.total_bytes - prev.total_bytes) / frames),
+                   (unsigned long)((curr.total_bus_us - prev.total_bus_us) / frames),
+                   (unsigned long)curr.last_bytes,
+                   (unsigned long)curr.last_windows);
+        prev = curr;
+
+#if configUSE_TICKLESS_IDLE == 1
+        // Fração do tempo com o núcleo parado em WFI (idle sem tick)
+        uint64_t now_us = time_us_64(), slept = tickless_idle_slept_us();
+        printf("[CPU] dormindo %lu%% do tempo\n",
+               (unsigned long)((slept - prev_slept) * 100 / (now_us - prev_us)));
+        prev_us = now_us;
+        prev_slept = slept;
+#endif
+    }
 }
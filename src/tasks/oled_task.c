@@ -1,89 +1,74 @@
 #include <stdio.h>
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
+#include "event_groups.h"
 #include "game.h"
+#include "render.h"
+#include "screen_fx.h"
+#include "game_snapshot.h"
 
-// Desenha o player
-static void draw_player(const GameObject *player) {
-    if (player->active)
-        ssd1306_draw_char(&oled_display, player->x, PLAYER_Y_POS, 1, '^');
-}
+// Taxa máxima de quadros; pode ser definida no build (-DOLED_FRAME_RATE_HZ=...)
+#ifndef OLED_FRAME_RATE_HZ
+#define OLED_FRAME_RATE_HZ 30
+#endif
 
-// Desenha o tiro do jogador
-static void draw_bullet(const GameObject *bullet) {
-    if (bullet->active)
-        ssd1306_draw_char(&oled_display, bullet->x, bullet->y, 1, '|');
-}
+#define OLED_FRAME_PERIOD pdMS_TO_TICKS(1000 / OLED_FRAME_RATE_HZ)
+#define OLED_WAIT_TICKS pdMS_TO_TICKS(5)   // reconfere o envio mesmo se o aviso se perder
+
+static GameState_t frame_state;    // estado sendo desenhado, fora da pilha da task
+static SemaphoreHandle_t frame_sent;
+
+// Fim do envio por DMA (em interrupção): libera quem espera o barramento
+static void frame_sent_irq(void *ctx) {
+    BaseType_t woken = pdFALSE;
 
-// Desenha alien
-static void draw_alien(const GameObject *alien) {
-    if (alien->active)
-        ssd1306_draw_char(&oled_display, alien->x, alien->y, 1, 'x');
+    (void)ctx;
+    xSemaphoreGiveFromISR(frame_sent, &woken);
+    portYIELD_FROM_ISR(woken);
 }
 
-// Desenha o tiro do alien
-static void draw_enemy_bullet(const GameObject *bullet) {
-    if (bullet->active)
-        ssd1306_draw_char(&oled_display, bullet->x, bullet->y, 1, '|');
+// Comandos e envios bloqueantes com um quadro no barramento: a task dorme em vez de girar
+static void wait_frame_sent(void *ctx) {
+    (void)ctx;
+    xSemaphoreTake(frame_sent, OLED_WAIT_TICKS);
 }
 
 void oled_display_task(void *pvParameters) {
-    char score_str[20];
-    char lives_str[10];
-
-    while (1) {
-        ssd1306_clear(&oled_display);
-
-        if (xSemaphoreTake(g_game_state_mutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-            switch (g_game_state.current_game_internal_state) {
-
-                case GAME_START_SCREEN:
-                    ssd1306_draw_string(&oled_display, 10, 20, 1, "BitDog Invaders");
-                    ssd1306_draw_string(&oled_display, 10, 35, 1, "Pressione B");
-                    break;
+    TickType_t last_frame = xTaskGetTickCount();
 
-                case GAME_PLAYING:
-                    draw_player(&g_game_state.player_obj);
+    // Envio do quadro por DMA: o buffer é redesenhado enquanto o anterior é transmitido
+    // (o transporte por PIO já usa DMA desde a inicialização)
+    frame_sent = xSemaphoreCreateBinary();
+    ssd1306_set_done_callback(&oled_display, frame_sent_irq, NULL);
+    ssd1306_set_wait_callback(&oled_display, wait_frame_sent, NULL);
+    if (oled_display.transport == &ssd1306_i2c_transport && !ssd1306_dma_init(&oled_display, frame_sent_irq, NULL))
+        printf("[OLED] DMA indisponivel, usando envio bloqueante\n");
 
-                    // Desenha tiros do jogador
-                    for (int i = 0; i < MAX_PLAYER_BULLETS; ++i)
-                        draw_bullet(&g_game_state.bullets[i]);
-
-                    // Desenha tiros dos inimigos
-                    for (int i = 0; i < MAX_ENEMY_BULLETS; ++i)
-                        draw_enemy_bullet(&g_game_state.enemy_bullets[i]);
-
-                    // Desenha aliens
-                    for (int r = 0; r < NUM_ALIEN_ROWS; ++r)
-                        for (int c = 0; c < NUM_ALIEN_COLS; ++c)
-                            draw_alien(&g_game_state.aliens[r][c]);
-
-                    sprintf(score_str, "Score: %d", g_game_state.score);
-                    ssd1306_draw_string(&oled_display, 0, 0, 1, score_str);
-                    sprintf(lives_str, "Vidas: %d", g_game_state.lives);
-                    ssd1306_draw_string(&oled_display, OLED_WIDTH - 50, 0, 1, lives_str);
-                    break;
-
-                case GAME_OVER:
-                    ssd1306_draw_string(&oled_display, 30, 20, 1, "GAME OVER");
-                    sprintf(score_str, "Final: %d", g_game_state.score);
-                    ssd1306_draw_string(&oled_display, 30, 35, 1, score_str);
-                    break;
+    while (1) {
+        // Dorme até a lógica do jogo avisar que o estado mudou: telas paradas não gastam CPU
+        xEventGroupWaitBits(g_game_events, GAME_EVENT_STATE_CHANGED, pdTRUE, pdFALSE, portMAX_DELAY);
+
+        // Depois de um tempo parado, o próximo quadro sai na hora em vez de tentar recuperar os perdidos
+        if (xTaskGetTickCount() - last_frame > OLED_FRAME_PERIOD)
+            last_frame = xTaskGetTickCount() - OLED_FRAME_PERIOD;
+        xTaskDelayUntil(&last_frame, OLED_FRAME_PERIOD);
+
+        // Quadro anterior ainda no barramento: pula este e tenta no próximo período
+        if (ssd1306_busy(&oled_display)) {
+            game_state_changed();
+            continue;
+        }
 
-                case GAME_WIN:
-                    ssd1306_draw_string(&oled_display, 25, 20, 1, "VOCE VENCEU!");
-                    sprintf(score_str, "Final: %d", g_game_state.score);
-                    ssd1306_draw_string(&oled_display, 30, 35, 1, score_str);
-                    break;
+        // Cópia do último estado publicado, sem mutex: a lógica segue enquanto o quadro é desenhado
+        game_snapshot_read(&frame_state);
+        bool changed = render_frame(&oled_display, &frame_state);
 
-                default:
-                    ssd1306_draw_string(&oled_display, 0, 0, 1, "Estado Desconhecido");
-                    break;
-            }
-            xSemaphoreGive(g_game_state_mutex);
-        }
+        // Efeitos do próprio controlador (linha inicial, scroll), antes dos dados do quadro
+        if (screen_fx_update(&oled_display, frame_state.current_game_internal_state, frame_state.lives))
+            game_state_changed();   // o efeito continua no próximo período
 
-        ssd1306_show(&oled_display);
-        vTaskDelay(pdMS_TO_TICKS(33));
+        if (changed)
+            ssd1306_show_async(&oled_display);
     }
 }
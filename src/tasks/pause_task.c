@@ -1,21 +1,45 @@
 #include "pause.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 #include "FreeRTOS.h"
 #include "task.h"
 
+#define PAUSE_PIN 5
+#define PAUSE_DEBOUNCE_MS 50
+
 volatile bool g_game_paused = false;
 
-// Task responsável pela pausa do jogo
+static TaskHandle_t pause_task_handle;
+
+// Borda de descida no botão: acorda a task, que filtra os repiques
+static void pause_button_irq(void) {
+    uint32_t mask = gpio_get_irq_event_mask(PAUSE_PIN);
+    BaseType_t woken = pdFALSE;
+
+    if (mask == 0)
+        return;
+    gpio_acknowledge_irq(PAUSE_PIN, mask);
+    if (pause_task_handle != NULL)
+        vTaskNotifyGiveFromISR(pause_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Task responsável pela pausa do jogo: dorme até o botão ser apertado
 void pause_task(void *pv) {
-    bool prev = true, curr;
-    const int PIN = 5;
+    pause_task_handle = xTaskGetCurrentTaskHandle();
+    gpio_add_raw_irq_handler(PAUSE_PIN, pause_button_irq);
+    gpio_set_irq_enabled(PAUSE_PIN, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
     while (1) {
-        curr = !gpio_get(PIN);
-        // Verifica transição de nível para alterar estado de pausa
-        if (curr && !prev) {
-            g_game_paused = !g_game_paused;
-        }
-        prev = curr;
-        vTaskDelay(pdMS_TO_TICKS(50));
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Espera o contato assentar e descarta as bordas dos repiques
+        vTaskDelay(pdMS_TO_TICKS(PAUSE_DEBOUNCE_MS));
+        ulTaskNotifyTake(pdTRUE, 0);
+        if (gpio_get(PAUSE_PIN))
+            continue;   // já solto: repique ao soltar ou ruído
+
+        g_game_paused = !g_game_paused;
     }
 }
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "game.h"
+#include "game_sim.h"
+#include "input_log.h"
+#include "rgb.h"
+#include "effects_task.h"
+
+#define JOYSTICK_VRX_PIN 27
+#define BTN_B_PIN 6
+#define JOYSTICK_DEAD_ZONE 200
+
+// Gravação das entradas da última partida; pode ser definida no build (-DINPUT_LOG_SIZE=...)
+#ifndef INPUT_LOG_SIZE
+#define INPUT_LOG_SIZE 8192
+#endif
+
+#define INPUT_LOG_EXPORT_LINE 32    // bytes por linha da exportação em hexadecimal
+
+#define SIM_STEP_TICKS pdMS_TO_TICKS(SIM_STEP_MS)
+
+static uint8_t input_log_buffer[INPUT_LOG_SIZE];
+static InputLog input_log;
+static InputReplay replay;
+static bool replaying;
+static TaskHandle_t sim_task_handle;
+
+// Qualquer borda do botão de tiro acorda a simulação parada numa tela sem jogo
+static void fire_button_irq(void) {
+    uint32_t mask = gpio_get_irq_event_mask(BTN_B_PIN);
+    BaseType_t woken = pdFALSE;
+
+    if (mask == 0)
+        return;
+    gpio_acknowledge_irq(BTN_B_PIN, mask);
+    if (sim_task_handle != NULL)
+        vTaskNotifyGiveFromISR(sim_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void read_input(GameInput_t *input) {
+    adc_select_input(JOYSTICK_VRX_PIN - 26);
+    uint16_t adc_x_raw = adc_read();
+
+    input->move = 0;
+    if (adc_x_raw < (2048 - JOYSTICK_DEAD_ZONE))
+        input->move = -1;
+    else if (adc_x_raw > (2048 + JOYSTICK_DEAD_ZONE))
+        input->move = 1;
+    input->fire = !gpio_get(BTN_B_PIN);
+}
+
+// Sons e LED pedidos pela simulação
+static void play_events(uint32_t events) {
+    if (events & SIM_EVENT_GAME_START)
+        led_set_color(GREEN);  // Mantemos o led verde de início de jogo
+    if (events & SIM_EVENT_PLAYER_SHOOT)
+        effect_send(EFFECT_PLAYER_SHOOT);
+    if (events & SIM_EVENT_ALIEN_HIT)
+        effect_send(EFFECT_ALIEN_HIT);
+    if (events & SIM_EVENT_PLAYER_HIT)
+        effect_send(EFFECT_PLAYER_HIT);
+    if (events & SIM_EVENT_GAME_OVER)
+        effect_send(EFFECT_GAME_OVER);
+    if (events & SIM_EVENT_GAME_WIN)
+        effect_send(EFFECT_GAME_WIN);
+}
+
+// Troca o jogo pela partida gravada, do começo; a gravação fica parada até o fim do replay
+static bool start_replay(void) {
+    if (!input_replay_open(&replay, input_log_buffer, input_log.len, &g_game_state))
+        return false;
+    replaying = true;
+    return true;
+}
+
+void sim_replay_request(void) {
+    xEventGroupSetBits(g_game_events, GAME_EVENT_REPLAY_REQUEST);
+    sim_wake();
+}
+
+void sim_wake(void) {
+    if (sim_task_handle != NULL)
+        xTaskNotifyGive(sim_task_handle);
+}
+
+// Nada a simular até um aviso: tela sem jogo em que o botão de tiro está
+// como o último passo viu (só uma borda nele muda alguma coisa)
+static bool sim_can_sleep(const GameInput_t *input) {
+    if (replaying || g_game_state.current_game_internal_state == GAME_PLAYING)
+        return false;
+    if (xEventGroupGetBits(g_game_events) & GAME_EVENT_REPLAY_REQUEST)
+        return false;
+    return input->fire == g_game_state.fire_held;
+}
+
+void sim_input_log_export(void) {
+    input_log.frozen = true;
+
+    printf("[INPUT] gravacao: %lu bytes%s\n", (unsigned long)input_log.len, input_log.full ? " (cheia)" : "");
+    for (size_t i = 0; i < input_log.len; ++i)
+        printf("%02x%s", input_log_buffer[i],
+               (i + 1) % INPUT_LOG_EXPORT_LINE == 0 || i + 1 == input_log.len ? "\n" : "");
+    printf("[INPUT] fim\n");
+
+    input_log.frozen = false;
+}
+
+// Única task que altera o estado do jogo: acorda a cada SIM_STEP_MS e roda os
+// passos devidos pelo tempo decorrido (game_sim_steps_due), que limita a
+// recuperação quando atrasa. Fora da partida, dorme até o botão de tiro ou
+// um pedido de replay avisarem (sim_wake)
+void game_sim_task(void *pvParameters) {
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t last_run = last_wake;
+    GameInput_t input;
+
+    input_log_init(&input_log, input_log_buffer, sizeof(input_log_buffer));
+
+    sim_task_handle = xTaskGetCurrentTaskHandle();
+    gpio_add_raw_irq_handler(BTN_B_PIN, fire_button_irq);
+    gpio_set_irq_enabled(BTN_B_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    while (1) {
+        xTaskDelayUntil(&last_wake, SIM_STEP_TICKS);
+
+        // Atrasada (CPU ocupada): realinha o despertar em vez de acordar em rajada
+        TickType_t now = xTaskGetTickCount();
+        last_wake += (now - last_wake) / SIM_STEP_TICKS * SIM_STEP_TICKS;
+
+        uint32_t events = 0;
+        if ((xEventGroupClearBits(g_game_events, GAME_EVENT_REPLAY_REQUEST) & GAME_EVENT_REPLAY_REQUEST) &&
+            start_replay())
+            events |= SIM_EVENT_CHANGED;
+
+        // Ao vivo, a tela inicial marca o começo da próxima partida gravada
+        bool live = !replaying;
+        if (live) {
+            read_input(&input);
+            if (g_game_state.current_game_internal_state == GAME_START_SCREEN)
+                input_log_arm(&input_log, &g_game_state);
+        }
+
+        uint32_t steps = game_sim_steps_due(&g_game_state, (now - last_run) * portTICK_PERIOD_MS);
+        last_run = now;
+
+        for (uint32_t i = 0; i < steps; ++i) {
+            if (replaying && !input_replay_next(&replay, &input)) {
+                // Fim da gravação: o jogador assume, e o que ele fizer não entra nela
+                replaying = false;
+                input_log.full = true;
+                read_input(&input);
+            }
+            events |= game_sim_step(&g_game_state, &input);
+        }
+
+        if (live) {
+            if (events & SIM_EVENT_GAME_START)
+                input_log_begin(&input_log);
+            input_log_record(&input_log, &input, steps);
+        }
+
+        play_events(events);
+        if (events & SIM_EVENT_CHANGED)
+            game_state_publish();
+
+        // Uma borda depois da leitura já deixou o aviso pendente: não se perde
+        if (sim_can_sleep(&input)) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            // O tempo parado não conta: volta sem passos atrasados para recuperar
+            last_wake = last_run = xTaskGetTickCount();
+        }
+    }
+}
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+Compilador de imagens para o formato de páginas do SSD1306.
+
+Lê uma imagem PBM (P1/P4) ou BMP (1, 24 ou 32 bits, sem compressão) e gera
+um par .h/.c com arrays constantes prontos para o framebuffer:
+
+  image   ssd1306_image_t, páginas de 8 linhas (desenho com ssd1306_draw_image)
+  sprite  ssd1306_sprite_t com os 8 deslocamentos verticais pré-calculados
+          (desenho com ssd1306_draw_sprite); com --frames a imagem é uma
+          folha de sprites dividida em quadros de mesma largura
+
+Pixels escuros (1 no PBM, preto no BMP) são os pixels acesos no display,
+a mesma convenção de ssd1306_bmp_show_image.
+
+Uso: asset_compiler.py --kind sprite --name alien [--frames 2] entrada.pbm saida_dir
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+
+class AssetError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------
+# Leitura das imagens: retorna (largura, altura, linhas de 0/1)
+# ---------------------------------------------------------------------------
+
+def read_pbm(data):
+    tokens = []
+    pos = 0
+
+    # cabeçalho: magic, largura e altura, com comentários '#'
+    while len(tokens) < 3:
+        m = re.compile(rb"\s*(#[^\n]*\n|\S+)").match(data, pos)
+        if not m:
+            raise AssetError("cabeçalho PBM incompleto")
+        pos = m.end()
+        if not m.group(1).startswith(b"#"):
+            tokens.append(m.group(1))
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+
+    if magic == b"P4":
+        pos += 1  # um único espaço separa o cabeçalho dos dados
+        row_bytes = (width + 7) // 8
+        if len(data) - pos < row_bytes * height:
+            raise AssetError("dados PBM truncados")
+        rows = []
+        for y in range(height):
+            row = data[pos + y * row_bytes:pos + (y + 1) * row_bytes]
+            rows.append([(row[x >> 3] >> (7 - (x & 7))) & 1 for x in range(width)])
+        return width, height, rows
+
+    if magic == b"P1":
+        bits = [int(c) for c in re.sub(rb"#[^\n]*", b"", data[pos:]).decode() if c in "01"]
+        if len(bits) < width * height:
+            raise AssetError("dados PBM truncados")
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    raise AssetError("formato PBM não suportado: %r" % magic)
+
+
+def read_bmp(data):
+    if len(data) < 54 or data[:2] != b"BM":
+        raise AssetError("cabeçalho BMP inválido")
+
+    off_bits, = struct.unpack_from("<I", data, 10)
+    header_size, width, height = struct.unpack_from("<Iii", data, 14)
+    bit_count, compression = struct.unpack_from("<HI", data, 28)
+
+    if compression != 0:
+        raise AssetError("BMP comprimido não suportado")
+
+    bottom_up = height > 0
+    height = abs(height)
+    row_bytes = ((width * bit_count + 31) // 32) * 4
+
+    if bit_count == 1:
+        table = 14 + header_size
+        dark = [sum(data[table + i * 4:table + i * 4 + 3]) < 384 for i in range(2)]
+    elif bit_count not in (24, 32):
+        raise AssetError("BMP de %d bits não suportado" % bit_count)
+
+    rows = []
+    for y in range(height):
+        src = off_bits + (height - 1 - y if bottom_up else y) * row_bytes
+        row = []
+        for x in range(width):
+            if bit_count == 1:
+                row.append(int(dark[(data[src + (x >> 3)] >> (7 - (x & 7))) & 1]))
+            else:
+                px = src + x * (bit_count // 8)
+                row.append(int(sum(data[px:px + 3]) < 384))
+        rows.append(row)
+    return width, height, rows
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:2] == b"BM":
+        return read_bmp(data)
+    if data[:2] in (b"P1", b"P4"):
+        return read_pbm(data)
+    raise AssetError("%s: formato desconhecido (use PBM ou BMP)" % path)
+
+
+# ---------------------------------------------------------------------------
+# Conversão para páginas
+# ---------------------------------------------------------------------------
+
+def to_columns(rows, x0, width, height):
+    """Colunas de bytes verticais, LSB em cima, como em ssd1306_sprite_init."""
+    parts = (height + 7) // 8
+    cols = []
+    for x in range(x0, x0 + width):
+        for page in range(parts):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            cols.append(byte)
+    return cols
+
+
+def image_bytes(rows, width, height):
+    """Página a página, width bytes por página."""
+    parts = (height + 7) // 8
+    cols = to_columns(rows, 0, width, height)
+    return [cols[x * parts + page] for page in range(parts) for x in range(width)]
+
+
+def sprite_bytes(cols, width, height):
+    """Mesmo layout de ssd1306_sprite_init: 8 cópias de (parts+1) páginas."""
+    parts = (height + 7) // 8
+    out = []
+    for shift in range(8):
+        for page in range(parts + 1):
+            for c in range(width):
+                cur = cols[c * parts + page] if page < parts else 0
+                prev = cols[c * parts + page - 1] if page > 0 else 0
+                out.append(((cur << shift) & 0xFF) | ((prev >> (8 - shift)) if shift else 0))
+    return out
+
+
+# ---------------------------------------------------------------------------
+# Geração do código
+# ---------------------------------------------------------------------------
+
+def c_array(name, values, ctype="uint8_t", fmt="0x%02x"):
+    lines = []
+    for i in range(0, len(values), 16):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + 16]) + ",")
+    return "static const %s %s[%d] = {\n%s\n};\n" % (ctype, name, len(values), "\n".join(lines))
+
+
+def generate(kind, name, frames, path, out_dir):
+    width, height, rows = read_image(path)
+
+    if width > 255 or height > 255:
+        raise AssetError("%s: imagem maior que 255x255" % path)
+    if width % frames:
+        raise AssetError("%s: largura %d não divisível em %d quadros" % (path, width, frames))
+
+    frame_width = width // frames
+    macro = "ASSET_" + name.upper()
+    source = os.path.basename(path)
+    banner = "// Gerado por tools/asset_compiler.py a partir de %s. Não editar.\n" % source
+
+    h = [banner,
+         "#ifndef %s_H\n#define %s_H\n\n" % (macro, macro),
+         '#include "ssd1306.h"\n\n',
+         "#define %s_WIDTH %d\n" % (macro, frame_width),
+         "#define %s_HEIGHT %d\n" % (macro, height)]
+    c = [banner, '#include "asset_%s.h"\n\n' % name]
+
+    if kind == "image":
+        if frames != 1:
+            raise AssetError("--frames só vale para sprites")
+        c.append(c_array("%s_data" % name, image_bytes(rows, width, height)))
+        c.append("\nconst ssd1306_image_t asset_%s = {%d, %d, %s_data};\n" % (name, width, height, name))
+        h.append("\nextern const ssd1306_image_t asset_%s;\n" % name)
+    else:
+        stride = (height + 7) // 8 + 1
+        h.append("#define %s_FRAMES %d\n" % (macro, frames))
+        for f in range(frames):
+            cols = to_columns(rows, f * frame_width, frame_width, height)
+            c.append(c_array("%s_data_%d" % (name, f), sprite_bytes(cols, frame_width, height)))
+            c.append("\n")
+        if frames == 1:
+            c.append("const ssd1306_sprite_t asset_%s = {%d, %d, %d, %s_data_0};\n"
+                     % (name, frame_width, height, stride, name))
+            h.append("\nextern const ssd1306_sprite_t asset_%s;\n" % name)
+        else:
+            c.append("const ssd1306_sprite_t asset_%s[%s_FRAMES] = {\n" % (name, macro))
+            for f in range(frames):
+                c.append("    {%d, %d, %d, %s_data_%d},\n" % (frame_width, height, stride, name, f))
+            c.append("};\n")
+            h.append("\nextern const ssd1306_sprite_t asset_%s[%s_FRAMES];\n" % (name, macro))
+
+    h.append("\n#endif\n")
+
+    os.makedirs(out_dir, exist_ok=True)
+    with open(os.path.join(out_dir, "asset_%s.h" % name), "w") as f:
+        f.write("".join(h))
+    with open(os.path.join(out_dir, "asset_%s.c" % name), "w") as f:
+        f.write("".join(c))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Converte imagens para o formato de páginas do SSD1306")
+    parser.add_argument("--kind", choices=("image", "sprite"), required=True)
+    parser.add_argument("--name", required=True, help="nome do asset (identificador C)")
+    parser.add_argument("--frames", type=int, default=1, help="quadros lado a lado na folha de sprites")
+    parser.add_argument("input")
+    parser.add_argument("out_dir")
+    args = parser.parse_args()
+
+    if not re.fullmatch(r"[A-Za-z_][A-Za-z0-9_]*", args.name):
+        parser.error("nome inválido: %s" % args.name)
+    if args.frames < 1:
+        parser.error("--frames deve ser >= 1")
+
+    try:
+        generate(args.kind, args.name, args.frames, args.input, args.out_dir)
+    except (AssetError, OSError) as e:
+        print("asset_compiler: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,81 @@
+# Compila imagens (PBM/BMP) para arrays constantes no formato de páginas do SSD1306.
+#
+#   add_display_asset(<gerador> <image|sprite> <nome> <arquivo> [FRAMES n])
+#   add_display_font(<gerador> <nome> <folha> CELL LxA [FIRST c] [LAST c]
+#                    [SPACING n] [SPACE_WIDTH n] [FIXED])
+#   target_display_assets(<alvo> <gerador>)
+#
+# <gerador> é um add_custom_target que só gera asset_<nome>.h/.c (ou
+# <nome>.h/.c para fontes) em ${CMAKE_CURRENT_BINARY_DIR}/assets.
+# target_display_assets adiciona os .c às fontes do alvo, o diretório aos
+# includes e faz o alvo esperar o gerador. Cada arquivo tem um único gerador:
+# a mesma regra em vários alvos independentes disputaria os arquivos num
+# build paralelo.
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(ASSET_COMPILER ${CMAKE_CURRENT_LIST_DIR}/asset_compiler.py)
+set(FONT_COMPILER ${CMAKE_CURRENT_LIST_DIR}/font_compiler.py)
+
+function(add_display_asset generator kind name file)
+    cmake_parse_arguments(ASSET "" "FRAMES" "" ${ARGN})
+    if(NOT ASSET_FRAMES)
+        set(ASSET_FRAMES 1)
+    endif()
+
+    get_filename_component(input ${file} ABSOLUTE)
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/assets)
+
+    add_custom_command(
+            OUTPUT ${out_dir}/asset_${name}.c ${out_dir}/asset_${name}.h
+            COMMAND Python3::Interpreter ${ASSET_COMPILER}
+                    --kind ${kind} --name ${name} --frames ${ASSET_FRAMES}
+                    ${input} ${out_dir}
+            DEPENDS ${input} ${ASSET_COMPILER}
+            COMMENT "Compilando asset ${name}"
+            VERBATIM)
+
+    target_sources(${generator} PRIVATE ${out_dir}/asset_${name}.c ${out_dir}/asset_${name}.h)
+    set_property(TARGET ${generator} APPEND PROPERTY DISPLAY_ASSET_SOURCES ${out_dir}/asset_${name}.c)
+endfunction()
+
+function(add_display_font generator name file)
+    cmake_parse_arguments(FONT "FIXED" "CELL;FIRST;LAST;SPACING;SPACE_WIDTH" "" ${ARGN})
+    if(NOT FONT_CELL)
+        message(FATAL_ERROR "add_display_font(${name}): CELL é obrigatório")
+    endif()
+
+    set(options --cell ${FONT_CELL})
+    foreach(opt FIRST LAST SPACING SPACE_WIDTH)
+        if(DEFINED FONT_${opt})
+            string(TOLOWER ${opt} flag)
+            string(REPLACE "_" "-" flag ${flag})
+            list(APPEND options --${flag} ${FONT_${opt}})
+        endif()
+    endforeach()
+    if(FONT_FIXED)
+        list(APPEND options --fixed)
+    endif()
+
+    get_filename_component(input ${file} ABSOLUTE)
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/assets)
+
+    add_custom_command(
+            OUTPUT ${out_dir}/${name}.c ${out_dir}/${name}.h
+            COMMAND Python3::Interpreter ${FONT_COMPILER} --name ${name} ${options}
+                    ${input} ${out_dir}
+            DEPENDS ${input} ${FONT_COMPILER} ${ASSET_COMPILER}
+            COMMENT "Compilando fonte ${name}"
+            VERBATIM)
+
+    target_sources(${generator} PRIVATE ${out_dir}/${name}.c ${out_dir}/${name}.h)
+    set_property(TARGET ${generator} APPEND PROPERTY DISPLAY_ASSET_SOURCES ${out_dir}/${name}.c)
+endfunction()
+
+function(target_display_assets target generator)
+    get_property(sources TARGET ${generator} PROPERTY DISPLAY_ASSET_SOURCES)
+
+    target_sources(${target} PRIVATE ${sources})
+    target_include_directories(${target} PRIVATE ${CMAKE_CURRENT_BINARY_DIR}/assets)
+    add_dependencies(${target} ${generator})
+endfunction()
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+Compilador de fontes para o formato de colunas do SSD1306.
+
+Lê uma folha de glifos (PBM/BMP, células de mesmo tamanho lado a lado, em
+ordem ASCII a partir de --first) e gera um ssd1306_font_t com:
+
+  - os glifos já em colunas de bytes verticais (LSB em cima), prontos
+    para serem copiados no framebuffer;
+  - a largura de cada glifo, sem as colunas vazias das bordas (texto
+    proporcional), ou a largura da célula com --fixed;
+  - o deslocamento de cada glifo na tabela, sem contas por caractere.
+
+Uso: font_compiler.py --name font_small --cell 5x8 [--first 32] [--spacing 1]
+                      [--space-width 3] [--fixed] folha.pbm saida_dir
+"""
+import argparse
+import os
+import re
+import sys
+
+from asset_compiler import AssetError, read_image, to_columns, c_array
+
+
+def glyph_columns(rows, gx, gy, cw, ch):
+    """Uma lista de (ch+7)/8 bytes por coluna da célula."""
+    pages = (ch + 7) // 8
+    flat = to_columns(rows[gy:gy + ch], gx, cw, ch)
+    return [flat[i:i + pages] for i in range(0, len(flat), pages)]
+
+
+def trim(cols, space_width):
+    """Remove as colunas vazias das bordas; glifo vazio vira um espaço."""
+    used = [i for i, col in enumerate(cols) if any(col)]
+    if not used:
+        return [[0] * len(cols[0])] * space_width
+    return cols[used[0]:used[-1] + 1]
+
+
+def generate(args):
+    width, height, rows = read_image(args.input)
+    cw, ch = args.cell
+
+    if width % cw or height % ch:
+        raise AssetError("%s: %dx%d não é múltiplo da célula %dx%d" % (args.input, width, height, cw, ch))
+    if ch > 255 or cw > 255:
+        raise AssetError("célula maior que 255 pixels")
+
+    per_row = width // cw
+    count = per_row * (height // ch)
+    if args.last is not None:
+        count = min(count, args.last - args.first + 1)
+    last = args.first + count - 1
+    if last > 255:
+        raise AssetError("a folha vai além do caractere 255")
+
+    data = []
+    offsets = []
+    widths = []
+    for i in range(count):
+        cols = glyph_columns(rows, (i % per_row) * cw, (i // per_row) * ch, cw, ch)
+        if not args.fixed:
+            cols = trim(cols, args.space_width)
+        offsets.append(len(data))
+        widths.append(len(cols))
+        for col in cols:
+            data.extend(col)
+
+    if len(data) > 0xFFFF:
+        raise AssetError("fonte maior que 64 KiB")
+
+    name = args.name
+    macro = name.upper()
+    banner = "// Gerado por tools/font_compiler.py a partir de %s. Não editar.\n" % os.path.basename(args.input)
+
+    h = [banner,
+         "#ifndef %s_H\n#define %s_H\n\n" % (macro, macro),
+         '#include "ssd1306.h"\n\n',
+         "#define %s_HEIGHT %d\n" % (macro, ch),
+         "#define %s_MAX_WIDTH %d\n" % (macro, max(widths)),
+         "\nextern const ssd1306_font_t %s;\n" % name,
+         "\n#endif\n"]
+
+    c = [banner, '#include "%s.h"\n\n' % name,
+         c_array("%s_data" % name, data), "\n",
+         c_array("%s_offsets" % name, offsets, "uint16_t", "%d"), "\n",
+         c_array("%s_widths" % name, widths, "uint8_t", "%d")]
+    c.append("\nconst ssd1306_font_t %s = {\n" % name)
+    c.append("    %d, %d, %d, %d, %d,\n" % (ch, (ch + 7) // 8, args.spacing, args.first, last))
+    c.append("    %s_widths, %s_offsets, %s_data\n};\n" % (name, name, name))
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    with open(os.path.join(args.out_dir, name + ".h"), "w") as f:
+        f.write("".join(h))
+    with open(os.path.join(args.out_dir, name + ".c"), "w") as f:
+        f.write("".join(c))
+
+
+def parse_cell(text):
+    m = re.fullmatch(r"(\d+)x(\d+)", text)
+    if not m:
+        raise argparse.ArgumentTypeError("célula no formato LxA, ex.: 5x8")
+    return int(m.group(1)), int(m.group(2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Converte uma folha de glifos em fonte do SSD1306")
+    parser.add_argument("--name", required=True, help="nome da fonte (identificador C)")
+    parser.add_argument("--cell", type=parse_cell, required=True, help="tamanho da célula, ex.: 5x8")
+    parser.add_argument("--first", type=int, default=32, help="primeiro caractere da folha")
+    parser.add_argument("--last", type=int, help="último caractere (padrão: a folha inteira)")
+    parser.add_argument("--spacing", type=int, default=1, help="colunas vazias após cada glifo")
+    parser.add_argument("--space-width", type=int, default=3, help="largura de glifos vazios")
+    parser.add_argument("--fixed", action="store_true", help="mantém a largura da célula")
+    parser.add_argument("input")
+    parser.add_argument("out_dir")
+    args = parser.parse_args()
+
+    if not re.fullmatch(r"[A-Za-z_][A-Za-z0-9_]*", args.name):
+        parser.error("nome inválido: %s" % args.name)
+
+    try:
+        generate(args)
+    except (AssetError, OSError) as e:
+        print("font_compiler: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())